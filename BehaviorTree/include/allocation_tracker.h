@@ -0,0 +1,93 @@
+#pragma once
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+#include "global.h"
+#include <unordered_map>
+#include <cstdint>
+
+struct AllocationStats {
+	AllocationStats() : allocations(0), bytes(0) {}
+
+	AllocationStats &operator +=(const AllocationStats &stats) {
+		allocations += stats.allocations;
+		bytes += stats.bytes;
+		return *this;
+	}
+
+	uint64_t allocations;
+	uint64_t bytes;
+};
+
+// the heap allocations made by the calling thread so far
+// They are counted by the operator new replaced in TRACK_ALLOCATIONS builds, and are always 0 otherwise.
+AllocationStats get_thread_allocations();
+
+// Measures the allocations made by the calling thread since its construction.
+class AllocationScope {
+public:
+	DISABLE_COPY_AND_ASSIGN(AllocationScope);
+
+	AllocationScope() : begin_(get_thread_allocations()) {}
+	AllocationStats Elapsed() const {
+		AllocationStats stats = get_thread_allocations();
+		stats.allocations -= begin_.allocations;
+		stats.bytes -= begin_.bytes;
+		return stats;
+	}
+
+private:
+	AllocationStats begin_;
+};
+
+// Allocations per API call, e.g. per function of the Python module.
+// The calls are keyed by the address of their name, a string literal, so that only the first call of an API allocates its entry.
+class AllocationTracker {
+public:
+	struct Calls {
+		Calls() : calls(0) {}
+
+		uint64_t calls;
+		AllocationStats stats;
+	};
+	DISABLE_COPY_AND_ASSIGN(AllocationTracker);
+
+	static AllocationTracker &Instance() {
+		static AllocationTracker instance;
+		return instance;
+	}
+	const std::unordered_map<const char *, Calls> *calls() const { return &calls_; }
+	void Record(const char *api, const AllocationStats &stats) {
+		Calls &calls = calls_[api];
+		++calls.calls;
+		calls.stats += stats;
+	}
+	void Reset() { calls_.clear(); }
+
+private:
+	AllocationTracker() {}
+
+private:
+	std::unordered_map<const char *, Calls> calls_;
+};
+
+// Records the allocations of the enclosing API call when it returns.
+class TrackedCall {
+public:
+	DISABLE_COPY_AND_ASSIGN(TrackedCall);
+
+	explicit TrackedCall(const char *api) : api_(api) {}
+	~TrackedCall() { AllocationTracker::Instance().Record(api_, scope_.Elapsed()); }
+
+private:
+	const char *api_;
+	AllocationScope scope_;
+};
+
+#ifdef TRACK_ALLOCATIONS
+#define TRACK_API_CALL(api) TrackedCall tracked_call(api)
+#else
+#define TRACK_API_CALL(api)
+#endif // TRACK_ALLOCATIONS
+
+#endif // !ALLOCATION_TRACKER_H
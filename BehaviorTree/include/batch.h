@@ -0,0 +1,122 @@
+#pragma once
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "global.h"
+#include "root.h"
+#include "leaf.h"
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+class Node;
+
+// State shared by the roots ticked together by a call of tick_batch.
+// A native condition node evaluates all the slots of the batch at once the first time
+// a root of the batch reaches it, then every root reads its own status from the result.
+// A root reaching a batch leaf yields, and the leaf is ticked once for all the waiting roots
+// before they resume.
+class Batch {
+public:
+	DISABLE_COPY_AND_ASSIGN(Batch);
+
+	Batch() : generation_(0), min_slot_(0), max_slot_(-1) {}
+	int min_slot() const { return min_slot_; }
+	size_t size() const { return max_slot_ >= min_slot_ ? max_slot_ - min_slot_ + 1 : 0; }
+	// starts a batch over the slots [min_slot, max_slot], invalidating the statuses of the last one
+	void Begin(int min_slot, int max_slot);
+	// returns NULL if the node has not been evaluated in this batch
+	const uint8_t *Find(const Node *node) const;
+	// returns the zeroed statuses of the node to evaluate, indexed by slot - min_slot()
+	uint8_t *Allocate(const Node *node);
+	// makes the root wait on the batch leaf of node
+	void Defer(const Node *node, const std::shared_ptr<Leaf> &leaf, Root *root, void *args);
+	// ticks every batch leaf roots wait on and hands the statuses to the roots, returns false if no root waits
+	bool TickLeaves();
+	// the roots of the batches of the calling thread waiting on a batch leaf or not resumed yet
+	// A commutative node is not reordered meanwhile, since these roots resume in their nodes.
+	static size_t &suspended_roots() {
+		static thread_local size_t roots = 0;
+		return roots;
+	}
+
+private:
+	struct Statuses {
+		Statuses() : generation(0) {}
+
+		unsigned int generation;
+		std::vector<uint8_t> values;
+	};
+	// the vectors are kept across the batches ticked with this object to avoid reallocation
+	std::unordered_map<const Node *, Statuses> statuses_;
+	struct Invocations {
+		std::shared_ptr<Leaf> leaf;
+		std::vector<Root *> roots;
+		std::vector<void *> args;
+		std::vector<int> statuses;
+	};
+	std::unordered_map<const Node *, Invocations> invocations_;
+	// the nodes of the batch leaves roots wait on
+	std::vector<const Node *> deferred_;
+	unsigned int generation_;
+	int min_slot_;
+	int max_slot_;
+};
+
+inline void Batch::Begin(int min_slot, int max_slot) {
+	if (++generation_ == 0) {
+		for (auto &pair : statuses_) pair.second.generation = 0;
+		++generation_;
+	}
+	min_slot_ = min_slot;
+	max_slot_ = max_slot;
+}
+
+inline const uint8_t *Batch::Find(const Node *node) const {
+	auto it = statuses_.find(node);
+	if (it == statuses_.end() || it->second.generation != generation_) return NULL;
+	return it->second.values.data();
+}
+
+inline uint8_t *Batch::Allocate(const Node *node) {
+	Statuses &statuses = statuses_[node];
+	statuses.generation = generation_;
+	statuses.values.assign(size(), 0);
+	return statuses.values.data();
+}
+
+inline void Batch::Defer(const Node *node, const std::shared_ptr<Leaf> &leaf, Root *root, void *args) {
+	Invocations &invocations = invocations_[node];
+	if (invocations.roots.empty()) {
+		invocations.leaf = leaf;
+		deferred_.push_back(node);
+	}
+	invocations.roots.push_back(root);
+	invocations.args.push_back(args);
+	root->waiting_leaf = node;
+	++suspended_roots();
+}
+
+inline bool Batch::TickLeaves() {
+	if (deferred_.empty()) return false;
+	for (const Node *node : deferred_) {
+		Invocations &invocations = invocations_[node];
+		size_t size = invocations.roots.size();
+		invocations.statuses.resize(size);
+		invocations.leaf->TickBatch(invocations.args.data(), invocations.statuses.data(), size);
+		for (size_t i = 0; i < size; ++i) {
+			Root *root = invocations.roots[i];
+			root->waiting_leaf = NULL;
+			root->done_leaf = node;
+			root->leaf_status = invocations.statuses[i];
+		}
+		invocations.leaf.reset();
+		invocations.roots.clear();
+		invocations.args.clear();
+	}
+	deferred_.clear();
+	return true;
+}
+
+#endif // !BATCH_H
@@ -0,0 +1,87 @@
+#pragma once
+#ifndef CHILD_ORDER_H
+#define CHILD_ORDER_H
+
+#include "global.h"
+#include <vector>
+
+class Node;
+
+// Online statistics of the children of a commutative composite node.
+// Every PERIOD traversals, the children are sorted by cost / probability of ending the traversal,
+// which minimizes the expected cost of a tick if the children are independent.
+// The statistics are halved after sorting so that the order follows the changes of the game.
+class ChildOrder {
+public:
+	static const unsigned int PERIOD = 1024;
+
+	explicit ChildOrder(size_t size) :
+			stats_(size), order_(size), children_(size), sorted_stats_(size), traversals_(0), generation_(0) {}
+	// changes every time the children are reordered, 0 until the first time
+	unsigned int generation() const { return generation_; }
+	void Record(size_t index, bool stopped, double cost) {
+		Stats &stats = stats_[index];
+		stats.ticks += 1;
+		stats.stops += stopped ? 1 : 0;
+		stats.cost += cost;
+	}
+	// called at the start of a traversal, returns true if the children are reordered
+	bool Update(Node **children, size_t size);
+
+private:
+	struct Stats {
+		Stats() : ticks(0), stops(0), cost(0) {}
+
+		double ticks;
+		double stops;
+		double cost;
+	};
+	// the children not ticked yet rank first, so that they are measured
+	static double Rank(const Stats &stats) {
+		if (stats.ticks == 0) return 0;
+		return (stats.cost / stats.ticks) / ((stats.stops + 1) / (stats.ticks + 2));
+	}
+
+private:
+	std::vector<Stats> stats_;
+	// reused by Update, so that reordering doesn't allocate
+	std::vector<size_t> order_;
+	std::vector<Node *> children_;
+	std::vector<Stats> sorted_stats_;
+	unsigned int traversals_;
+	unsigned int generation_;
+};
+
+inline bool ChildOrder::Update(Node **children, size_t size) {
+	if (++traversals_ < PERIOD || size != stats_.size()) return false;
+	traversals_ = 0;
+
+	for (size_t i = 0; i < size; ++i) order_[i] = i;
+	// insertion sort, stable and without the buffer std::stable_sort may allocate
+	for (size_t i = 1; i < size; ++i) {
+		size_t index = order_[i];
+		double rank = Rank(stats_[index]);
+		size_t j = i;
+		for (; j > 0 && rank < Rank(stats_[order_[j - 1]]); --j) order_[j] = order_[j - 1];
+		order_[j] = index;
+	}
+
+	bool changed = false;
+	children_.assign(children, children + size);
+	for (size_t i = 0; i < size; ++i) {
+		changed = changed || order_[i] != i;
+		children[i] = children_[order_[i]];
+		Stats &stats = sorted_stats_[i];
+		stats = stats_[order_[i]];
+		stats.ticks /= 2;
+		stats.stops /= 2;
+		stats.cost /= 2;
+	}
+	stats_.swap(sorted_stats_);
+
+	if (!changed) return false;
+	if (++generation_ == 0) ++generation_;
+	return true;
+}
+
+#endif // !CHILD_ORDER_H
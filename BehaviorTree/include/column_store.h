@@ -0,0 +1,126 @@
+#pragma once
+#ifndef COLUMN_STORE_H
+#define COLUMN_STORE_H
+
+#include "global.h"
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COMPARE_SSE2
+#include <emmintrin.h>
+#endif
+
+enum CompareOp {
+	LESS,
+	LESS_EQUAL,
+	GREATER,
+	GREATER_EQUAL,
+	EQUAL,
+	NOT_EQUAL,
+	COMPARE_OP_SIZE,
+};
+
+// Per-agent float operands of the native condition nodes.
+// A column is indexed by the slot of a root, so the operands of all agents are contiguous.
+class ColumnStore {
+public:
+	typedef std::vector<float> Column;
+	DISABLE_COPY_AND_ASSIGN(ColumnStore);
+
+	static ColumnStore &Instance() {
+		static ColumnStore instance;
+		return instance;
+	}
+	// returns NULL if the column doesn't exist
+	const Column *column(int id) const {
+		if (id < 0 || static_cast<size_t>(id) >= columns_.size()) return NULL;
+		return &columns_[id];
+	}
+	Column &MutableColumn(int id) {
+		if (static_cast<size_t>(id) >= columns_.size()) columns_.resize(id + 1);
+		return columns_[id];
+	}
+	bool Get(int id, int slot, float &value) const {
+		const Column *values = column(id);
+		if (values == NULL || slot < 0 || static_cast<size_t>(slot) >= values->size()) return false;
+		value = (*values)[slot];
+		return true;
+	}
+	void Set(int id, int slot, float value) {
+		Column &values = MutableColumn(id);
+		if (static_cast<size_t>(slot) >= values.size()) values.resize(slot + 1);
+		values[slot] = value;
+	}
+
+private:
+	ColumnStore() {}
+
+private:
+	std::vector<Column> columns_;
+};
+
+inline bool Compare(int op, float lhs, float rhs) {
+	switch (op) {
+	case LESS: return lhs < rhs;
+	case LESS_EQUAL: return lhs <= rhs;
+	case GREATER: return lhs > rhs;
+	case GREATER_EQUAL: return lhs >= rhs;
+	case EQUAL: return lhs == rhs;
+	case NOT_EQUAL: return lhs != rhs;
+	default: return false;
+	}
+}
+
+#ifdef COMPARE_SSE2
+template <int op> inline __m128 CompareSimd(__m128 lhs, __m128 rhs);
+template <> inline __m128 CompareSimd<LESS>(__m128 lhs, __m128 rhs) { return _mm_cmplt_ps(lhs, rhs); }
+template <> inline __m128 CompareSimd<LESS_EQUAL>(__m128 lhs, __m128 rhs) { return _mm_cmple_ps(lhs, rhs); }
+template <> inline __m128 CompareSimd<GREATER>(__m128 lhs, __m128 rhs) { return _mm_cmpgt_ps(lhs, rhs); }
+template <> inline __m128 CompareSimd<GREATER_EQUAL>(__m128 lhs, __m128 rhs) { return _mm_cmpge_ps(lhs, rhs); }
+template <> inline __m128 CompareSimd<EQUAL>(__m128 lhs, __m128 rhs) { return _mm_cmpeq_ps(lhs, rhs); }
+template <> inline __m128 CompareSimd<NOT_EQUAL>(__m128 lhs, __m128 rhs) { return _mm_cmpneq_ps(lhs, rhs); }
+
+// SUCCESS for the lanes that hold, FAILURE for the others
+template <int op> inline __m128i CompareStatusSimd(const float *lhs, const float *rhs, __m128 value) {
+	__m128 right = rhs ? _mm_loadu_ps(rhs) : value;
+	__m128i mask = _mm_castps_si128(CompareSimd<op>(_mm_loadu_ps(lhs), right));
+	return _mm_add_epi32(_mm_set1_epi32(FAILURE), mask);
+}
+#endif // COMPARE_SSE2
+
+// Writes the status of lhs[i] op rhs[i] (or lhs[i] op value if rhs is NULL) to statuses[i].
+template <int op>
+inline void CompareColumns(const float *lhs, const float *rhs, float value, size_t size, uint8_t *statuses) {
+	size_t i = 0;
+
+#ifdef COMPARE_SSE2
+	__m128 values = _mm_set1_ps(value);
+	for (; i + 16 <= size; i += 16) {
+		__m128i s0 = CompareStatusSimd<op>(lhs + i, rhs ? rhs + i : NULL, values);
+		__m128i s1 = CompareStatusSimd<op>(lhs + i + 4, rhs ? rhs + i + 4 : NULL, values);
+		__m128i s2 = CompareStatusSimd<op>(lhs + i + 8, rhs ? rhs + i + 8 : NULL, values);
+		__m128i s3 = CompareStatusSimd<op>(lhs + i + 12, rhs ? rhs + i + 12 : NULL, values);
+		__m128i packed = _mm_packus_epi16(_mm_packs_epi32(s0, s1), _mm_packs_epi32(s2, s3));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(statuses + i), packed);
+	}
+#endif // COMPARE_SSE2
+
+	for (; i < size; ++i)
+		statuses[i] = Compare(op, lhs[i], rhs ? rhs[i] : value) ? SUCCESS : FAILURE;
+}
+
+inline void CompareColumns(int op, const float *lhs, const float *rhs, float value, size_t size, uint8_t *statuses) {
+	switch (op) {
+	case LESS: CompareColumns<LESS>(lhs, rhs, value, size, statuses); break;
+	case LESS_EQUAL: CompareColumns<LESS_EQUAL>(lhs, rhs, value, size, statuses); break;
+	case GREATER: CompareColumns<GREATER>(lhs, rhs, value, size, statuses); break;
+	case GREATER_EQUAL: CompareColumns<GREATER_EQUAL>(lhs, rhs, value, size, statuses); break;
+	case EQUAL: CompareColumns<EQUAL>(lhs, rhs, value, size, statuses); break;
+	case NOT_EQUAL: CompareColumns<NOT_EQUAL>(lhs, rhs, value, size, statuses); break;
+	default: memset(statuses, 0, size); break;
+	}
+}
+
+#endif // !COLUMN_STORE_H
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef COMPLETION_QUEUE_H
+#define COMPLETION_QUEUE_H
+
+#include "global.h"
+#include <unordered_map>
+#include <mutex>
+
+// Collects the results of the work started by async leaves.
+// A leaf takes a ticket when it starts; the status is pushed here once the work is done and
+// the waiting node pops it on the next tick without ticking the leaf again.
+// Push may be called from any thread.
+class CompletionQueue {
+public:
+	typedef unsigned long Ticket;
+	DISABLE_COPY_AND_ASSIGN(CompletionQueue);
+
+	static CompletionQueue &Instance() {
+		static CompletionQueue instance;
+		return instance;
+	}
+	// returns the ticket of a new pending work
+	Ticket Start();
+	void Push(Ticket ticket, int status);
+	bool Pop(Ticket ticket, int &status);
+	void Cancel(Ticket ticket) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		entries_.erase(ticket);
+	}
+	size_t size() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		return entries_.size();
+	}
+
+private:
+	CompletionQueue() : next_ticket_(0) {}
+	Ticket NextTicket() {
+		if (++next_ticket_ == 0) ++next_ticket_;
+		return next_ticket_;
+	}
+
+private:
+	struct Entry {
+		Entry() : done(false), status(RUNNING) {}
+
+		bool done;
+		int status;
+	};
+	std::unordered_map<Ticket, Entry> entries_;
+	Ticket next_ticket_;
+	std::mutex mutex_;
+};
+
+inline CompletionQueue::Ticket CompletionQueue::Start() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	Ticket ticket = NextTicket();
+	entries_[ticket] = Entry();
+	return ticket;
+}
+
+inline void CompletionQueue::Push(Ticket ticket, int status) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = entries_.find(ticket);
+	if (it == entries_.end()) return;
+	it->second.done = true;
+	it->second.status = status;
+}
+
+inline bool CompletionQueue::Pop(Ticket ticket, int &status) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = entries_.find(ticket);
+	if (it == entries_.end()) {
+		status = ERROR;
+		return true;
+	}
+	if (!it->second.done) return false;
+	status = it->second.status;
+	entries_.erase(it);
+	return true;
+}
+
+#endif // !COMPLETION_QUEUE_H
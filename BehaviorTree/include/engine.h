@@ -0,0 +1,29 @@
+#pragma once
+#ifndef ENGINE_H
+#define ENGINE_H
+
+// C++ API of the behavior tree engine, usable without the Python interpreter.
+// Register nodes with NodeManager::Instance().AddNode, passing a Leaf (e.g. NativeLeaf) for the leaf nodes,
+// then bind roots to their tree and tick them. Different roots may be ticked by different threads
+// as long as no node is added and the profiler and tick_batch are not used at the same time.
+// In lazy mode (NodeManager::SetLazy), a node is built by the first tick reaching it, so build every tree
+// with NodeManager::MaterializeTree before ticking it from several threads.
+// A commutative node updates its statistics and reorders its children while it is ticked,
+// so a tree with commutative nodes must be ticked by one thread at a time.
+
+#include "global.h"
+#include "root.h"
+#include "leaf.h"
+#include "node_manager.h"
+
+// binds the root to the node of node_id, returns false if there is no such node
+bool BindRoot(Root &root, int node_id);
+// ticks the root and returns its status, 0 if the root is not bound or its replay is over
+int TickRoot(Root &root, void *args);
+// ticks the roots together, see tick_batch, a root listed more than once is ticked once
+// It may be called by a leaf ticked in a batch; a root already ticked by an outer call is skipped with status 0.
+void TickBatch(Root **roots, void **args, int *statuses, size_t size);
+// drops the work the async leaves of the root are still waiting on, call it before deleting a root
+void CancelTickets(Root &root);
+
+#endif // !ENGINE_H
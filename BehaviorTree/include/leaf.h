@@ -0,0 +1,55 @@
+#pragma once
+#ifndef LEAF_H
+#define LEAF_H
+
+#include "global.h"
+#include "completion_queue.h"
+#include <functional>
+#include <memory>
+#include <string>
+
+// The action or the condition ticked by a leaf node.
+// args is the pointer passed to TickRoot, e.g. the arguments tuple in the Python binding.
+class Leaf {
+public:
+	virtual ~Leaf() {}
+	virtual int Tick(void *args) = 0;
+	// Starts the work of an async leaf. Returns RUNNING and sets the ticket taken from the completion queue
+	// if the status will be pushed later, otherwise returns the status and sets the ticket to 0.
+	virtual int Start(void *args, CompletionQueue::Ticket &ticket) {
+		ticket = 0;
+		return Tick(args);
+	}
+	// Ticks a batch leaf once for all the roots of a batch reaching it, writing the status of args[i] to statuses[i].
+	virtual void TickBatch(void **args, int *statuses, size_t size) {
+		for (size_t i = 0; i < size; ++i) statuses[i] = Tick(args[i]);
+	}
+	virtual const char *name() const { return "leaf"; }
+};
+
+// A leaf calling a C++ function.
+class NativeLeaf : public Leaf {
+public:
+	typedef std::function<int(void *args)> Function;
+
+	NativeLeaf(const std::string &name, const Function &function) : name_(name), function_(function) {}
+	int Tick(void *args) override { return function_(args); }
+	const char *name() const override { return name_.c_str(); }
+
+private:
+	std::string name_;
+	Function function_;
+};
+
+// Builds the leaves of the functions of a binding, e.g. the Python functions, so that a node defined
+// in lazy mode only keeps a reference to its function until it is built. The functions are compared by address.
+class LeafFactory {
+public:
+	virtual ~LeafFactory() {}
+	// keeps the function alive while a definition refers to it
+	virtual void Retain(void *function) = 0;
+	virtual void Release(void *function) = 0;
+	virtual std::shared_ptr<Leaf> Create(void *function) = 0;
+};
+
+#endif // !LEAF_H
@@ -1,285 +1,651 @@
-#pragma once
-#ifndef NODE_H
-#define NODE_H
-
-#include "global.h"
-#include "node_data.h"
-#include "root.h"
-#include "stddef.h"
-#include "profile/profiler.h"
-#include <ctime>
-
-#define container_of(ptr, type, member) \
-	( (type *)((char *)ptr - offsetof(type, member)) )
-
-#define SHOULD_PRINT_TRACE_INFO (container_of(&tree_data, Root, tree_data)->debug)
-
-#define PRINT_TRACE_INFO(func, format, info) \
-	do { \
-		char timestamp[64]; \
-		get_timestamp(timestamp, sizeof(timestamp)); \
-		char buffer[256]; \
-		snprintf(buffer, sizeof(buffer), " - behavior_tree - %s : " format, __func__, info); \
-		func("%s%s", timestamp, buffer); \
-	} while(0)
-
-#define PRINT_SIMPLE_TRACE_INFO \
-	do { \
-		if (SHOULD_PRINT_TRACE_INFO) \
-			PRINT_TRACE_INFO(PySys_WriteStdout, "node %d\n", id_); \
-	} while (0)
-
-class Node {
-public:
-	typedef int(Node::*Function)(PyObject *args, TreeData *&tree_data);
-	Function Tick;
-
-	explicit Node(int id) : Tick(NULL), id_(id), children_(NULL), size_(0), function_(NULL) {}
-	Node(const Node &node) :
-			Tick(node.Tick),
-			id_(node.id_),
-			children_(new Node *[node.size_]),
-			size_(node.size_),
-			function_(node.function_) {
-		memcpy(children_, node.children_, sizeof(Node *) * node.size_);
-		Py_XINCREF(function_);
-	}
-	~Node() {
-		Tick = NULL;
-		id_ = 0;
-		delete[] children_;
-		children_ = NULL;
-		size_ = 0;
-
-#ifdef Py_DEBUG
-		// The process terminates and the destruction is called by static variable's destructor(~NodeManager()).
-		// The Python interpreter is finalized at the moment.
-		if (!Py_IsInitialized()) {
-			return;
-		}
-#endif
-
-		Py_XDECREF(function_);
-		function_ = NULL;
-	}
-	Node &operator =(const Node &node) {
-		Tick = node.Tick;
-		id_ = node.id_;
-
-		delete[] children_;
-		children_ = new Node *[node.size_];
-		memcpy(children_, node.children_, sizeof(Node *) * node.size_);
-		size_ = node.size_;
-
-		Py_XDECREF(function_);
-		function_ = node.function_;
-		Py_XINCREF(function_);
-
-		return *this;
-	}
-	Node **children() { return children_; }
-	void SetChildren(Node **children, size_t size);
-	size_t size() { return size_; }
-	void SetFunction(PyObject *function);
-
-	// hook tick method to profile
-	int ProfileTick(PyObject *args, TreeData *&tree_data);
-
-	// tick methods
-	// common methods
-	int CallPythonFunction(PyObject *args, TreeData *&tree_data);
-	int TickNode(PyObject *args, TreeData *&tree_data);
-	// composite node methods
-	int RunUntilSuccess(PyObject *args, TreeData *&tree_data);
-	int RunUntilFail(PyObject *args, TreeData *&tree_data);
-	int MemRunUntilSuccess(PyObject *args, TreeData *&tree_data);
-	int MemRunUntilFail(PyObject *args, TreeData *&tree_data);
-	// decorator node methods
-	int ReportSuccess(PyObject *args, TreeData *&tree_data);
-	int ReportFailure(PyObject *args, TreeData *&tree_data);
-	int RevertStatus(PyObject *args, TreeData *&tree_data);
-
-private:
-	int id_;
-	Node **children_;
-	size_t size_;
-	PyObject *function_;
-};
-
-#ifndef PROFILE_TICK
-#define TICK_CHILDREN(i) ( (children_[i]->*(children_[i]->Tick))(args, tree_data) )
-#else
-#define TICK_CHILDREN(i) ( children_[i]->ProfileTick(args, tree_data) )
-#endif // !PROFILE_TICK
-
-inline void Node::SetChildren(Node **children, size_t size) {
-	delete[] children_;
-	children_ = new Node *[size];
-	memcpy(children_, children, sizeof(Node *) * size);
-	size_ = size;
-}
-
-inline void Node::SetFunction(PyObject *function) {
-	Py_XDECREF(function_);
-	function_ = function;
-	Py_XINCREF(function_);
-}
-
-inline int Node::ProfileTick(PyObject *args, TreeData *&tree_data) {
-	Profiler &profiler = Profiler::Instance();
-	if (!profiler.enable()) return (this->*(this->Tick))(args, tree_data);
-
-	clock_t start = clock();
-	int status = (this->*(this->Tick))(args, tree_data);
-	clock_t end = clock();
-	profiler.AddProfileData(id_, end - start);
-	return status;
-}
-
-inline int Node::CallPythonFunction(PyObject *args, TreeData *&tree_data) {
-#ifdef TRACE_TICK
-	PyObject *function_name = PyObject_GetAttrString(function_, "__name__");
-	if (SHOULD_PRINT_TRACE_INFO)
-		PRINT_TRACE_INFO(PySys_WriteStdout, "%s\n", PyString_AsString(function_name));
-	Py_DECREF(function_name);
-#endif // TRACE_TICK
-
-	PyObject *result = PyObject_CallObject(function_, args);
-	if (result == NULL) {
-
-#if defined(_DEBUG) | defined(TRACE_TICK)
-		PyErr_Print();
-#endif
-
-		PyErr_Clear();
-		return ERROR;
-	}
-	int status = PyInt_AsLong(result);
-
-#if defined(_DEBUG) | defined(TRACE_TICK)
-	if (PyErr_Occurred()) {
-		PyObject *function_name = PyObject_GetAttrString(function_, "__name__");
-		PRINT_TRACE_INFO(PySys_WriteStderr, "%s - ", PyString_AsString(function_name));
-		PyErr_Print();
-		Py_DECREF(function_name);
-	}
-#endif
-
-	PyErr_Clear();
-	Py_DECREF(result);
-	return status;
-}
-
-inline int Node::TickNode(PyObject *args, TreeData *&tree_data) {
-#ifdef TRACE_TICK
-	PRINT_SIMPLE_TRACE_INFO;
-#endif // TRACE_TICK
-
-	if (size_ > 0) {
-		return TICK_CHILDREN(0);
-	}
-	return ERROR;
-}
-
-inline int Node::RunUntilSuccess(PyObject *args, TreeData *&tree_data) {
-#ifdef TRACE_TICK
-	PRINT_SIMPLE_TRACE_INFO;
-#endif // TRACE_TICK
-
-	int status = FAILURE;
-	for (size_t i = 0; i < size_; ++i) {
-		if ((status = TICK_CHILDREN(i)) & SUCCESS)
-			return status;
-	}
-	return status;
-}
-
-inline int Node::RunUntilFail(PyObject *args, TreeData *&tree_data) {
-#ifdef TRACE_TICK
-	PRINT_SIMPLE_TRACE_INFO;
-#endif // TRACE_TICK
-
-	int status = SUCCESS;
-	for (size_t i = 0; i < size_; ++i) {
-		if ((status = TICK_CHILDREN(i)) & FAILURE)
-			return status;
-	}
-	return status;
-}
-
-inline int Node::MemRunUntilSuccess(PyObject *args, TreeData *&tree_data) {
-#ifdef TRACE_TICK
-	PRINT_SIMPLE_TRACE_INFO;
-#endif // TRACE_TICK
-
-	int status = FAILURE;
-	size_t &index = (*tree_data)[id_].child_index;
-	while (index < size_) {
-		status = TICK_CHILDREN(index);
-		if (status & (SUCCESS | RUNNING)) {
-			if (status != RUNNING) index = 0;
-			return status;
-		}
-		++index;
-	}
-	index = 0;
-	return status;
-}
-
-inline int Node::MemRunUntilFail(PyObject *args, TreeData *&tree_data) {
-#ifdef TRACE_TICK
-	PRINT_SIMPLE_TRACE_INFO;
-#endif // TRACE_TICK
-
-	int status = SUCCESS;
-	size_t &index = (*tree_data)[id_].child_index;
-	while (index < size_) {
-		status = TICK_CHILDREN(index);
-		if (status & (FAILURE | RUNNING)) {
-			if (status != RUNNING) index = 0;
-			return status;
-		}
-		++index;
-	}
-	index = 0;
-	return status;
-}
-
-inline int Node::ReportSuccess(PyObject *args, TreeData *&tree_data) {
-#ifdef TRACE_TICK
-	PRINT_SIMPLE_TRACE_INFO;
-#endif // TRACE_TICK
-
-	if (size_ > 0) {
-		TICK_CHILDREN(0);
-		return SUCCESS;
-	}
-	return ERROR;
-}
-
-inline int Node::ReportFailure(PyObject *args, TreeData *&tree_data) {
-#ifdef TRACE_TICK
-	PRINT_SIMPLE_TRACE_INFO;
-#endif // TRACE_TICK
-
-	if (size_ > 0) {
-		TICK_CHILDREN(0);
-		return FAILURE;
-	}
-	return ERROR;
-}
-
-inline int Node::RevertStatus(PyObject *args, TreeData *&tree_data) {
-#ifdef TRACE_TICK
-	PRINT_SIMPLE_TRACE_INFO;
-#endif // TRACE_TICK
-
-	if (size_ > 0) {
-		int status = TICK_CHILDREN(0);
-		if (status & RUNNING) return status;
-		else return (status ^ (SUCCESS | FAILURE));
-	}
-	return ERROR;
-}
-
-#endif // !NODE_H
+#pragma once
+#ifndef NODE_H
+#define NODE_H
+
+#include "global.h"
+#include "node_data.h"
+#include "root.h"
+#include "stddef.h"
+#include "completion_queue.h"
+#include "leaf.h"
+#include "column_store.h"
+#include "batch.h"
+#include "child_order.h"
+#include "profile/profiler.h"
+#include <ctime>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#define container_of(ptr, type, member) \
+	( (type *)((char *)ptr - offsetof(type, member)) )
+
+#define ROOT_OF(data) (container_of(&data, Root, tree_data))
+
+#define SHOULD_PRINT_TRACE_INFO (ROOT_OF(tree_data)->debug)
+
+#define PRINT_TRACE_INFO(func, format, info) \
+	do { \
+		char timestamp[64]; \
+		get_timestamp(timestamp, sizeof(timestamp)); \
+		char buffer[256]; \
+		snprintf(buffer, sizeof(buffer), " - behavior_tree - %s : " format, __func__, info); \
+		func("%s%s", timestamp, buffer); \
+	} while(0)
+
+#define PRINT_SIMPLE_TRACE_INFO \
+	do { \
+		if (SHOULD_PRINT_TRACE_INFO) \
+			PRINT_TRACE_INFO(trace_stdout, "node %d\n", id_); \
+	} while (0)
+
+class Node {
+public:
+	typedef int(Node::*Function)(void *args, TreeData *&tree_data);
+	Function Tick;
+
+	explicit Node(int id) :
+			Tick(NULL), id_(id), children_(NULL), size_(0), params_(NULL), params_size_(0) {}
+	Node(const Node &node) :
+			Tick(node.Tick),
+			id_(node.id_),
+			children_(new Node *[node.size_]),
+			size_(node.size_),
+			leaf_(node.leaf_),
+			params_(new double[node.params_size_]),
+			params_size_(node.params_size_),
+			order_(node.order_ ? new ChildOrder(*node.order_) : NULL) {
+		memcpy(children_, node.children_, sizeof(Node *) * node.size_);
+		memcpy(params_, node.params_, sizeof(double) * node.params_size_);
+	}
+	~Node() {
+		Tick = NULL;
+		id_ = 0;
+		delete[] children_;
+		children_ = NULL;
+		size_ = 0;
+		delete[] params_;
+		params_ = NULL;
+		params_size_ = 0;
+		leaf_.reset();
+		order_.reset();
+	}
+	Node &operator =(const Node &node) {
+		Tick = node.Tick;
+		id_ = node.id_;
+
+		delete[] children_;
+		children_ = new Node *[node.size_];
+		memcpy(children_, node.children_, sizeof(Node *) * node.size_);
+		size_ = node.size_;
+
+		delete[] params_;
+		params_ = new double[node.params_size_];
+		memcpy(params_, node.params_, sizeof(double) * node.params_size_);
+		params_size_ = node.params_size_;
+
+		leaf_ = node.leaf_;
+		order_.reset(node.order_ ? new ChildOrder(*node.order_) : NULL);
+
+		return *this;
+	}
+	int id() { return id_; }
+	Node **children() { return children_; }
+	void SetChildren(Node **children, size_t size);
+	size_t size() { return size_; }
+	const std::shared_ptr<Leaf> &leaf() { return leaf_; }
+	void SetLeaf(const std::shared_ptr<Leaf> &leaf) { leaf_ = leaf; }
+	double *params() { return params_; }
+	void SetParams(const double *params, size_t size);
+	size_t params_size() { return params_size_; }
+	bool commutative() { return order_.get() != NULL; }
+	// a commutative node reorders its children by their statistics, call it after SetChildren
+	void SetCommutative(bool commutative) { order_.reset(commutative ? new ChildOrder(size_) : NULL); }
+
+	// hook tick method to profile
+	int ProfileTick(void *args, TreeData *&tree_data);
+	// tick method of a node defined in lazy mode, builds the node from its definition on the first tick
+	int Materialize(void *args, TreeData *&tree_data);
+
+	// tick methods
+	// common methods
+	int TickLeaf(void *args, TreeData *&tree_data);
+	int TickAsyncLeaf(void *args, TreeData *&tree_data);
+	// ticked once for all the roots of a batch tick reaching it, see Leaf::TickBatch
+	int TickBatchLeaf(void *args, TreeData *&tree_data);
+	int TickNode(void *args, TreeData *&tree_data);
+	// composite node methods
+	int RunUntilSuccess(void *args, TreeData *&tree_data);
+	int RunUntilFail(void *args, TreeData *&tree_data);
+	int MemRunUntilSuccess(void *args, TreeData *&tree_data);
+	int MemRunUntilFail(void *args, TreeData *&tree_data);
+	// decorator node methods
+	int ReportSuccess(void *args, TreeData *&tree_data);
+	int ReportFailure(void *args, TreeData *&tree_data);
+	int RevertStatus(void *args, TreeData *&tree_data);
+	// stateful decorator node methods, parameters are passed by add_node
+	int Repeat(void *args, TreeData *&tree_data);
+	int Retry(void *args, TreeData *&tree_data);
+	int Timeout(void *args, TreeData *&tree_data);
+	int Cooldown(void *args, TreeData *&tree_data);
+	int RateLimit(void *args, TreeData *&tree_data);
+	// condition node methods, operands are read from the column store by the slot of the root
+	int CompareValue(void *args, TreeData *&tree_data);
+	int CompareColumns(void *args, TreeData *&tree_data);
+
+private:
+	// leaves go through the tick log of the root while it records or replays
+	int TickLoggedLeaf(Function invoke, void *args, TreeData *&tree_data);
+	// the current time for the time-dependent decorators, which goes through the tick log like a leaf status
+	double LoggedTime(TreeData *&tree_data);
+	int InvokeLeaf(void *args, TreeData *&tree_data);
+	int InvokeAsyncLeaf(void *args, TreeData *&tree_data);
+	int InvokeBatchLeaf(void *args, TreeData *&tree_data);
+	int InvokeCompareValue(void *args, TreeData *&tree_data);
+	int InvokeCompareColumns(void *args, TreeData *&tree_data);
+	int TickCondition(TreeData *&tree_data, int rhs_column, float value);
+	// drops the state of the nodes of the subtree and the work its async leaves wait on, so that it starts over
+	void ResetState(TreeData &tree_data);
+	// ticks the children of a commutative node until one of them returns a status in stop
+	int TickCommutative(void *args, TreeData *&tree_data, int stop, int status);
+
+private:
+	int id_;
+	Node **children_;
+	size_t size_;
+	std::shared_ptr<Leaf> leaf_;
+	double *params_;
+	size_t params_size_;
+	std::unique_ptr<ChildOrder> order_;
+};
+
+#ifndef PROFILE_TICK
+#define TICK_CHILDREN(i) ( (children_[i]->*(children_[i]->Tick))(args, tree_data) )
+#else
+#define TICK_CHILDREN(i) ( children_[i]->ProfileTick(args, tree_data) )
+#endif // !PROFILE_TICK
+
+inline void Node::SetChildren(Node **children, size_t size) {
+	delete[] children_;
+	children_ = new Node *[size];
+	memcpy(children_, children, sizeof(Node *) * size);
+	size_ = size;
+}
+
+inline void Node::SetParams(const double *params, size_t size) {
+	delete[] params_;
+	params_ = new double[size];
+	memcpy(params_, params, sizeof(double) * size);
+	params_size_ = size;
+}
+
+inline int Node::ProfileTick(void *args, TreeData *&tree_data) {
+	Profiler &profiler = Profiler::Instance();
+	if (!profiler.enable()) return (this->*(this->Tick))(args, tree_data);
+
+	clock_t start = clock();
+	int status = (this->*(this->Tick))(args, tree_data);
+	clock_t end = clock();
+	profiler.AddProfileData(id_, end - start);
+	return status;
+}
+
+inline int Node::TickLoggedLeaf(Function invoke, void *args, TreeData *&tree_data) {
+	TickLog *tick_log = ROOT_OF(tree_data)->tick_log;
+	if (tick_log == NULL) return (this->*invoke)(args, tree_data);
+	if (tick_log->mode() == TickLog::REPLAY) return tick_log->Replay(id_);
+
+	double start_time = tick_log->latency() ? get_monotonic_time() : 0;
+	int status = (this->*invoke)(args, tree_data);
+	// a waiting batch leaf is recorded by the resumed tick
+	if (status != YIELDED) tick_log->Record(id_, status, start_time);
+	return status;
+}
+
+inline double Node::LoggedTime(TreeData *&tree_data) {
+	TickLog *tick_log = ROOT_OF(tree_data)->tick_log;
+	if (tick_log == NULL) return get_monotonic_time();
+	if (tick_log->mode() == TickLog::REPLAY) return tick_log->ReplayTime(id_);
+
+	double now = get_monotonic_time();
+	tick_log->RecordTime(id_, now);
+	return now;
+}
+
+inline int Node::TickLeaf(void *args, TreeData *&tree_data) {
+	return TickLoggedLeaf(&Node::InvokeLeaf, args, tree_data);
+}
+
+inline int Node::TickAsyncLeaf(void *args, TreeData *&tree_data) {
+	return TickLoggedLeaf(&Node::InvokeAsyncLeaf, args, tree_data);
+}
+
+inline int Node::TickBatchLeaf(void *args, TreeData *&tree_data) {
+	return TickLoggedLeaf(&Node::InvokeBatchLeaf, args, tree_data);
+}
+
+inline int Node::InvokeLeaf(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	if (SHOULD_PRINT_TRACE_INFO)
+		PRINT_TRACE_INFO(trace_stdout, "%s\n", leaf_->name());
+#endif // TRACE_TICK
+
+	return leaf_->Tick(args);
+}
+
+inline int Node::InvokeAsyncLeaf(void *args, TreeData *&tree_data) {
+	CompletionQueue &queue = CompletionQueue::Instance();
+	Root *root = ROOT_OF(tree_data);
+	NodeData &data = (*tree_data)[id_];
+	int status;
+
+	// the counter is the last tick the leaf was waiting in, the work is dropped
+	// if the leaf was not ticked since the previous one, i.e. the parent stopped waiting on it
+	if (data.ticket && data.counter != root->tick_count && data.counter + 1 != root->tick_count) {
+		queue.Cancel(data.ticket);
+		data.ticket = 0;
+	}
+
+	// waiting on the started work, skip the leaf until it is done
+	if (data.ticket) {
+		if (!queue.Pop(data.ticket, status)) {
+			data.counter = root->tick_count;
+			return RUNNING;
+		}
+		data.ticket = 0;
+		return status;
+	}
+
+#ifdef TRACE_TICK
+	if (SHOULD_PRINT_TRACE_INFO)
+		PRINT_TRACE_INFO(trace_stdout, "%s\n", leaf_->name());
+#endif // TRACE_TICK
+
+	status = leaf_->Start(args, data.ticket);
+	if (!data.ticket) return status;
+
+	// the work may be done already
+	if (!queue.Pop(data.ticket, status)) {
+		data.counter = root->tick_count;
+		return RUNNING;
+	}
+	data.ticket = 0;
+	return status;
+}
+
+inline int Node::InvokeBatchLeaf(void *args, TreeData *&tree_data) {
+	Root *root = ROOT_OF(tree_data);
+	// resumed after the leaf was ticked for the batch
+	if (root->done_leaf == this) {
+		root->done_leaf = NULL;
+		return root->leaf_status;
+	}
+
+#ifdef TRACE_TICK
+	if (SHOULD_PRINT_TRACE_INFO)
+		PRINT_TRACE_INFO(trace_stdout, "%s\n", leaf_->name());
+#endif // TRACE_TICK
+
+	if (root->batch == NULL) {
+		int status;
+		leaf_->TickBatch(&args, &status, 1);
+		return status;
+	}
+	root->batch->Defer(this, leaf_, root, args);
+	return YIELDED;
+}
+
+inline int Node::TickNode(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	if (size_ > 0) {
+		return TICK_CHILDREN(0);
+	}
+	return ERROR;
+}
+
+inline int Node::RunUntilSuccess(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	if (order_) return TickCommutative(args, tree_data, SUCCESS, FAILURE);
+
+	Root *root = ROOT_OF(tree_data);
+	int status = FAILURE;
+	size_t start = root->Resume(id_);
+	for (size_t i = start; i < size_; ++i) {
+		if (i > start && root->ShouldYield())
+			return root->Suspend(id_, i);
+		if ((status = TICK_CHILDREN(i)) == YIELDED)
+			return root->Suspend(id_, i);
+		if (i == start) root->EndResume();
+		if (status & SUCCESS)
+			return status;
+	}
+	return status;
+}
+
+inline int Node::RunUntilFail(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	if (order_) return TickCommutative(args, tree_data, FAILURE, SUCCESS);
+
+	Root *root = ROOT_OF(tree_data);
+	int status = SUCCESS;
+	size_t start = root->Resume(id_);
+	for (size_t i = start; i < size_; ++i) {
+		if (i > start && root->ShouldYield())
+			return root->Suspend(id_, i);
+		if ((status = TICK_CHILDREN(i)) == YIELDED)
+			return root->Suspend(id_, i);
+		if (i == start) root->EndResume();
+		if (status & FAILURE)
+			return status;
+	}
+	return status;
+}
+
+inline int Node::TickCommutative(void *args, TreeData *&tree_data, int stop, int status) {
+	Root *root = ROOT_OF(tree_data);
+	// the children are only reordered between traversals, and not while roots of a batch may resume in the node
+	if (!root->suspended_in(id_) && Batch::suspended_roots() == 0) order_->Update(children_, size_);
+	size_t start = root->Resume(id_, order_->generation());
+	for (size_t i = start; i < size_; ++i) {
+		if (i > start && root->ShouldYield())
+			return root->Suspend(id_, i, order_->generation());
+		double begin = get_monotonic_time();
+		if ((status = TICK_CHILDREN(i)) == YIELDED)
+			return root->Suspend(id_, i, order_->generation());
+		if (i == start) root->EndResume();
+		order_->Record(i, (status & stop) != 0, get_monotonic_time() - begin);
+		if (status & stop)
+			return status;
+	}
+	return status;
+}
+
+inline int Node::MemRunUntilSuccess(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	int status = FAILURE;
+	size_t &index = (*tree_data)[id_].child_index;
+	size_t start = index;
+	while (index < size_) {
+		if (index > start && ROOT_OF(tree_data)->ShouldYield())
+			return YIELDED;
+		status = TICK_CHILDREN(index);
+		if (status == YIELDED)
+			return status;
+		if (status & (SUCCESS | RUNNING)) {
+			if (status != RUNNING) index = 0;
+			return status;
+		}
+		++index;
+	}
+	index = 0;
+	return status;
+}
+
+inline int Node::MemRunUntilFail(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	int status = SUCCESS;
+	size_t &index = (*tree_data)[id_].child_index;
+	size_t start = index;
+	while (index < size_) {
+		if (index > start && ROOT_OF(tree_data)->ShouldYield())
+			return YIELDED;
+		status = TICK_CHILDREN(index);
+		if (status == YIELDED)
+			return status;
+		if (status & (FAILURE | RUNNING)) {
+			if (status != RUNNING) index = 0;
+			return status;
+		}
+		++index;
+	}
+	index = 0;
+	return status;
+}
+
+inline int Node::ReportSuccess(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	if (size_ > 0) {
+		if (TICK_CHILDREN(0) == YIELDED) return YIELDED;
+		return SUCCESS;
+	}
+	return ERROR;
+}
+
+inline int Node::ReportFailure(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	if (size_ > 0) {
+		if (TICK_CHILDREN(0) == YIELDED) return YIELDED;
+		return FAILURE;
+	}
+	return ERROR;
+}
+
+inline int Node::RevertStatus(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	if (size_ > 0) {
+		int status = TICK_CHILDREN(0);
+		if (status & (RUNNING | YIELDED)) return status;
+		else return (status ^ (SUCCESS | FAILURE));
+	}
+	return ERROR;
+}
+
+// params: [times] -- tick the child until it succeeds the given times, forever if times <= 0
+inline int Node::Repeat(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	if (size_ == 0) return ERROR;
+
+	unsigned int times = params_[0] > 0 ? static_cast<unsigned int>(params_[0]) : 0;
+	unsigned int &counter = (*tree_data)[id_].counter;
+	while (true) {
+		int status = TICK_CHILDREN(0);
+		if (status == RUNNING || status == YIELDED) return status;
+		if (status != SUCCESS) {
+			counter = 0;
+			return status;
+		}
+		if (times == 0) return RUNNING;
+		if (++counter >= times) {
+			counter = 0;
+			return SUCCESS;
+		}
+		if (ROOT_OF(tree_data)->ShouldYield()) return YIELDED;
+	}
+}
+
+// params: [attempts] -- tick the child until it doesn't fail within the given attempts, forever if attempts <= 0
+inline int Node::Retry(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	if (size_ == 0) return ERROR;
+
+	unsigned int attempts = params_[0] > 0 ? static_cast<unsigned int>(params_[0]) : 0;
+	unsigned int &counter = (*tree_data)[id_].counter;
+	while (true) {
+		int status = TICK_CHILDREN(0);
+		if (status == RUNNING || status == YIELDED) return status;
+		if (status != FAILURE) {
+			counter = 0;
+			return status;
+		}
+		if (attempts == 0) return RUNNING;
+		if (++counter >= attempts) {
+			counter = 0;
+			return FAILURE;
+		}
+		if (ROOT_OF(tree_data)->ShouldYield()) return YIELDED;
+	}
+}
+
+// params: [seconds] -- fail if the child keeps running longer than the given seconds
+inline int Node::Timeout(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	if (size_ == 0) return ERROR;
+
+	Root *root = ROOT_OF(tree_data);
+	NodeData &data = (*tree_data)[id_];
+	double now = LoggedTime(tree_data);
+	// the counter is the last tick the child was running in, the timer restarts if it is not the previous one
+	// (or the current one, for a resumed tick)
+	bool running = data.counter != 0 && (data.counter == root->tick_count || data.counter + 1 == root->tick_count);
+	if (!running) {
+		data.timestamp = now;
+	}
+	else if (now - data.timestamp >= params_[0]) {
+		data.counter = 0;
+		// the child is aborted, the next tick starts it again
+		children_[0]->ResetState(*tree_data);
+		return FAILURE;
+	}
+
+	int status = TICK_CHILDREN(0);
+	data.counter = (status == RUNNING || status == YIELDED) ? root->tick_count : 0;
+	return status;
+}
+
+inline void Node::ResetState(TreeData &tree_data) {
+	auto it = tree_data.find(id_);
+	if (it != tree_data.end()) {
+		if (it->second.ticket) CompletionQueue::Instance().Cancel(it->second.ticket);
+		it->second = NodeData();
+	}
+	for (size_t i = 0; i < size_; ++i) children_[i]->ResetState(tree_data);
+}
+
+// params: [seconds] -- fail without ticking the child until the given seconds after it has finished
+inline int Node::Cooldown(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	if (size_ == 0) return ERROR;
+
+	// the timestamp is the time the child can be ticked again
+	double &ready_time = (*tree_data)[id_].timestamp;
+	if (LoggedTime(tree_data) < ready_time) return FAILURE;
+
+	int status = TICK_CHILDREN(0);
+	if (status != RUNNING && status != YIELDED)
+		ready_time = LoggedTime(tree_data) + params_[0];
+	return status;
+}
+
+// params: [max_ticks, seconds] -- fail without ticking the child once it has been ticked max_ticks times in the seconds
+inline int Node::RateLimit(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	if (size_ == 0) return ERROR;
+
+	// the timestamp is the start of the current period
+	NodeData &data = (*tree_data)[id_];
+	double now = LoggedTime(tree_data);
+	if (now - data.timestamp >= params_[1]) {
+		data.timestamp = now;
+		data.counter = 0;
+	}
+	if (data.counter >= params_[0]) return FAILURE;
+
+	int status = TICK_CHILDREN(0);
+	// a yielded child is ticked again by the resumed tick
+	if (status != YIELDED) ++data.counter;
+	return status;
+}
+
+// params: [op, column, value] -- succeed if column[slot] op value
+// the conditions read the game world, so they go through the tick log like the leaves
+inline int Node::CompareValue(void *args, TreeData *&tree_data) {
+	return TickLoggedLeaf(&Node::InvokeCompareValue, args, tree_data);
+}
+
+// params: [op, lhs_column, rhs_column] -- succeed if lhs_column[slot] op rhs_column[slot]
+inline int Node::CompareColumns(void *args, TreeData *&tree_data) {
+	return TickLoggedLeaf(&Node::InvokeCompareColumns, args, tree_data);
+}
+
+inline int Node::InvokeCompareValue(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	return TickCondition(tree_data, -1, static_cast<float>(params_[2]));
+}
+
+inline int Node::InvokeCompareColumns(void *args, TreeData *&tree_data) {
+#ifdef TRACE_TICK
+	PRINT_SIMPLE_TRACE_INFO;
+#endif // TRACE_TICK
+
+	return TickCondition(tree_data, static_cast<int>(params_[2]), 0);
+}
+
+inline int Node::TickCondition(TreeData *&tree_data, int rhs_column, float value) {
+	Root *root = ROOT_OF(tree_data);
+	int op = static_cast<int>(params_[0]);
+	int lhs_column = static_cast<int>(params_[1]);
+	if (root->slot < 0 || op < 0 || op >= COMPARE_OP_SIZE) return ERROR;
+
+	ColumnStore &store = ColumnStore::Instance();
+	if (root->batch == NULL) {
+		float lhs, rhs = value;
+		if (!store.Get(lhs_column, root->slot, lhs)) return ERROR;
+		if (rhs_column >= 0 && !store.Get(rhs_column, root->slot, rhs)) return ERROR;
+		return Compare(op, lhs, rhs) ? SUCCESS : FAILURE;
+	}
+
+	// evaluate the whole batch the first time one of its roots gets here
+	Batch &batch = *root->batch;
+	const uint8_t *statuses = batch.Find(this);
+	if (statuses == NULL) {
+		uint8_t *values = batch.Allocate(this);
+		const ColumnStore::Column *lhs = store.column(lhs_column);
+		const ColumnStore::Column *rhs = rhs_column >= 0 ? store.column(rhs_column) : NULL;
+		if (lhs != NULL && (rhs_column < 0 || rhs != NULL)) {
+			size_t size = lhs->size();
+			if (rhs != NULL && rhs->size() < size) size = rhs->size();
+			size_t begin = batch.min_slot();
+			size = size > begin ? size - begin : 0;
+			if (size > batch.size()) size = batch.size();
+			::CompareColumns(op, lhs->data() + begin, rhs ? rhs->data() + begin : NULL, value, size, values);
+		}
+		statuses = values;
+	}
+	size_t index = root->slot - batch.min_slot();
+	if (root->slot < batch.min_slot() || index >= batch.size() || statuses[index] == 0) return ERROR;
+	return statuses[index];
+}
+
+#endif // !NODE_H
@@ -1,11 +1,16 @@
-#pragma once
-#ifndef NODE_DATA_H
-#define NODE_DATA_H
-
-struct NodeData {
-	NodeData() : child_index(0) {}
-
-	size_t child_index;
-};
-
-#endif // !NODE_DATA_H
+#pragma once
+#ifndef NODE_DATA_H
+#define NODE_DATA_H
+
+struct NodeData {
+	NodeData() : child_index(0), ticket(0), counter(0), timestamp(0) {}
+
+	size_t child_index;
+	// completion ticket of the future an async leaf is waiting on
+	unsigned long ticket;
+	// state of the stateful decorators, the last tick an async leaf waited in
+	unsigned int counter;
+	double timestamp;
+};
+
+#endif // !NODE_DATA_H
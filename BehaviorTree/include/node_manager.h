@@ -1,100 +1,411 @@
-#pragma once
-#ifndef NODE_MANAGER_H
-#define NODE_MANAGER_H
-
-#include "global.h"
-#include "node.h"
-#include <vector>
-#include <unordered_map>
-#include <algorithm>
-
-class NodeManager {
-public:
-	DISABLE_COPY_AND_ASSIGN(NodeManager);
-
-	~NodeManager() {
-		for (auto it = nodes_.begin(); it != nodes_.end(); ++it) {
-			delete it->second;
-			it->second = NULL;
-		}
-		nodes_.clear();
-		functions_.clear();
-	}
-	static NodeManager &Instance() {
-		static NodeManager instance;
-		return instance;
-	}
-	const std::unordered_map<int, Node *> *nodes() { return &nodes_; }
-	void AddNode(int id, size_t index, const std::vector<int> &children_ids, PyObject *function);
-
-private:
-	NodeManager() {
-		InitFunctions();
-	}
-	void InitFunctions();
-	Node *CreateNode(int id, size_t index, const std::vector<int> &children_ids, PyObject *function);
-	bool IsNodeDataValid(size_t index, const std::vector<int> &children_ids, PyObject *function);
-
-private:
-	std::unordered_map<int, Node *> nodes_;
-	std::vector<Node::Function> functions_;
-};
-
-inline void NodeManager::AddNode(int id, size_t index, const std::vector<int> &children_ids, PyObject *function) {
-	Node *node = CreateNode(id, index, children_ids, function);
-	if (node == NULL)
-		return;
-	
-	if (nodes_.find(id) != nodes_.end()) {
-		*nodes_[id] = *node;
-		delete node;
-		node = NULL;
-	}
-	else nodes_[id] = node;
-}
-
-inline Node *NodeManager::CreateNode(int id, size_t index, const std::vector<int> &children_ids, PyObject *function) {
-	if (!IsNodeDataValid(index, children_ids, function))
-		return NULL;
-
-	Node *node = new Node(id);
-	node->Tick = functions_[index];
-	node->SetFunction(function);
-	
-	size_t size = children_ids.size();
-	Node **children = new Node *[size];
-	for (size_t i = 0; i < size; ++i)
-		children[i] = nodes_[children_ids[i]];
-	node->SetChildren(children, size);
-
-	delete[] children;
-	children = NULL;
-	return node;
-}
-
-inline bool NodeManager::IsNodeDataValid(size_t index, const std::vector<int> &children_ids, PyObject *function) {
-	if (index >= functions_.size()) return false;
-	if (index == 0 && !PyCallable_Check(function)) return false;
-	for (size_t i = 0; i < children_ids.size(); ++i) {
-		auto pointer = nodes_.find(children_ids[i]);
-		if (pointer == nodes_.end() || !pointer->second)
-			return false;
-	}
-	return true;
-}
-
-inline void NodeManager::InitFunctions() {
-	functions_ = {
-		&Node::CallPythonFunction, 
-		&Node::TickNode,
-		&Node::RunUntilSuccess,
-		&Node::RunUntilFail,
-		&Node::MemRunUntilSuccess,
-		&Node::MemRunUntilFail,
-		&Node::ReportSuccess,
-		&Node::ReportFailure,
-		&Node::RevertStatus,
-	};
-}
-
-#endif // !NODE_MANAGER_H
+#pragma once
+#ifndef NODE_MANAGER_H
+#define NODE_MANAGER_H
+
+#include "global.h"
+#include "node.h"
+#include "leaf.h"
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <cstring>
+#include <cstdint>
+
+class NodeManager {
+public:
+	DISABLE_COPY_AND_ASSIGN(NodeManager);
+
+	~NodeManager() {
+		for (auto it = nodes_.begin(); it != nodes_.end(); ++it) {
+			delete it->second;
+			it->second = NULL;
+		}
+		nodes_.clear();
+		functions_.clear();
+	}
+	static NodeManager &Instance() {
+		static NodeManager instance;
+		return instance;
+	}
+	// the materialized nodes, a node defined in lazy mode is added when a root or a materialized parent refers to it
+	const std::unordered_map<int, Node *> *nodes() { return &nodes_; }
+	bool lazy() { return lazy_; }
+	// in lazy mode, AddNode only keeps the definition and the node is built the first time a root reaches it
+	void SetLazy(bool lazy) { lazy_ = lazy; }
+	bool HasNode(int id);
+	// returns the node of id, NULL if it is not defined
+	Node *GetNode(int id);
+	// builds the node from its definition, returns false if it has no definition
+	bool Materialize(Node *node);
+	// builds the node of id and all its descendants, returns false if a node has no definition
+	// Call it before ticking the tree from several threads, a node built by a tick is rewritten while other threads may read it.
+	bool MaterializeTree(int id);
+	// names of the tick functions, in the order of their indexes
+	const std::vector<const char *> &function_names() { return function_names_; }
+	// returns the index of the tick function, -1 if not found
+	int FindFunction(const std::string &name);
+	// a commutative RunUntilSuccess or RunUntilFail node reorders its children to reduce the cost of a tick
+	void AddNode(int id, size_t index, const std::vector<int> &children_ids, const std::shared_ptr<Leaf> &leaf,
+			const std::vector<double> &params, bool commutative = false);
+	// builds the leaves of the nodes added by AddFunctionNode, it must outlive the node manager
+	void SetLeafFactory(LeafFactory *leaf_factory) { leaf_factory_ = leaf_factory; }
+	// like AddNode, with the leaf of function built by the leaf factory, none if function is NULL
+	// In lazy mode, the definition only keeps a reference to the function until the node is built.
+	void AddFunctionNode(int id, size_t index, const std::vector<int> &children_ids, void *function,
+			const std::vector<double> &params, bool commutative = false);
+
+private:
+	NodeManager() : lazy_(false), leaf_factory_(NULL) {
+		InitFunctions();
+	}
+	void InitFunctions();
+	void Define(int id, size_t index, const std::vector<int> &children_ids, const std::shared_ptr<Leaf> &leaf,
+			void *function, const std::vector<double> &params, bool commutative);
+	// the definitions of the leaves, shared by the definitions of the same function
+	int32_t AddLeaf(const std::shared_ptr<Leaf> &leaf, void *function);
+	void ReleaseLeaf(int32_t leaf_index);
+	// releases the leaf of the definition of id, if any
+	void ReleaseDefinition(int id);
+	// returns the node of id, creating a node to materialize if it is only defined
+	Node *FindNode(int id);
+	// Materialize without taking the lock
+	bool MaterializeNode(Node *node);
+	template <typename T> void Write(T value) {
+		definitions_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+	template <typename T> T Read(size_t &offset) {
+		T value;
+		memcpy(&value, definitions_.data() + offset, sizeof(value));
+		offset += sizeof(value);
+		return value;
+	}
+	Node *CreateNode(int id, size_t index, const std::vector<int> &children_ids, const std::shared_ptr<Leaf> &leaf,
+			const std::vector<double> &params, bool commutative);
+	bool IsNodeDataValid(size_t index, const std::vector<int> &children_ids, bool has_leaf,
+			const std::vector<double> &params, bool commutative);
+	static bool IsLeafFunction(Node::Function function) {
+		return function == &Node::TickLeaf || function == &Node::TickAsyncLeaf || function == &Node::TickBatchLeaf;
+	}
+	static size_t ParamsSize(Node::Function function) {
+		if (function == &Node::Repeat || function == &Node::Retry || function == &Node::Timeout ||
+				function == &Node::Cooldown) return 1;
+		if (function == &Node::RateLimit) return 2;
+		if (function == &Node::CompareValue || function == &Node::CompareColumns) return 3;
+		return 0;
+	}
+	static bool IsReorderable(Node::Function function) {
+		return function == &Node::RunUntilSuccess || function == &Node::RunUntilFail;
+	}
+
+private:
+	struct LeafDefinition {
+		LeafDefinition() : function(NULL), references(0) {}
+
+		// built on the first materialization if the definition only has the function
+		std::shared_ptr<Leaf> leaf;
+		void *function;
+		size_t references;
+	};
+
+	std::unordered_map<int, Node *> nodes_;
+	std::vector<Node::Function> functions_;
+	std::vector<const char *> function_names_;
+	bool lazy_;
+	// the definitions added in lazy mode, serialized back to back
+	// format: [index][commutative][children_size][params_size][leaf_index][child_id]...[param]...
+	// a redefined node appends a new definition, the old one is not released but its leaf is
+	std::string definitions_;
+	std::unordered_map<int, size_t> offsets_;
+	std::vector<LeafDefinition> leaves_;
+	// the unused entries of leaves_, and the entry of each function
+	std::vector<int32_t> free_leaves_;
+	std::unordered_map<void *, int32_t> function_leaves_;
+	LeafFactory *leaf_factory_;
+	// nodes are materialized during ticks
+	std::mutex mutex_;
+};
+
+// defined here since it needs the definitions kept by the node manager
+inline int Node::Materialize(void *args, TreeData *&tree_data) {
+	if (!NodeManager::Instance().Materialize(this)) return ERROR;
+	return (this->*Tick)(args, tree_data);
+}
+
+inline int NodeManager::FindFunction(const std::string &name) {
+	for (size_t i = 0; i < function_names_.size(); ++i) {
+		if (name == function_names_[i]) return static_cast<int>(i);
+	}
+	return -1;
+}
+
+inline bool NodeManager::HasNode(int id) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return nodes_.find(id) != nodes_.end() || offsets_.find(id) != offsets_.end();
+}
+
+inline Node *NodeManager::GetNode(int id) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return FindNode(id);
+}
+
+inline void NodeManager::AddNode(int id, size_t index, const std::vector<int> &children_ids,
+		const std::shared_ptr<Leaf> &leaf, const std::vector<double> &params, bool commutative) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (lazy_) {
+		if (!IsNodeDataValid(index, children_ids, leaf != NULL, params, commutative))
+			return;
+		Define(id, index, children_ids, leaf, NULL, params, commutative);
+		// a materialized node is built again from the new definition on its next tick
+		auto it = nodes_.find(id);
+		if (it != nodes_.end()) it->second->Tick = &Node::Materialize;
+		return;
+	}
+
+	Node *node = CreateNode(id, index, children_ids, leaf, params, commutative);
+	if (node == NULL)
+		return;
+	ReleaseDefinition(id);
+	offsets_.erase(id);
+
+	if (nodes_.find(id) != nodes_.end()) {
+		*nodes_[id] = *node;
+		delete node;
+		node = NULL;
+	}
+	else nodes_[id] = node;
+}
+
+inline void NodeManager::AddFunctionNode(int id, size_t index, const std::vector<int> &children_ids,
+		void *function, const std::vector<double> &params, bool commutative) {
+	if (function != NULL && leaf_factory_ == NULL) return;
+	if (!lazy_) {
+		AddNode(id, index, children_ids, function ? leaf_factory_->Create(function) : std::shared_ptr<Leaf>(),
+			params, commutative);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (!IsNodeDataValid(index, children_ids, function != NULL, params, commutative))
+		return;
+	Define(id, index, children_ids, std::shared_ptr<Leaf>(), function, params, commutative);
+	auto it = nodes_.find(id);
+	if (it != nodes_.end()) it->second->Tick = &Node::Materialize;
+}
+
+inline bool NodeManager::Materialize(Node *node) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return MaterializeNode(node);
+}
+
+inline bool NodeManager::MaterializeTree(int id) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	Node *node = FindNode(id);
+	if (node == NULL) return false;
+
+	// the trees may share subtrees
+	std::unordered_set<Node *> visited;
+	std::vector<Node *> stack(1, node);
+	while (!stack.empty()) {
+		node = stack.back();
+		stack.pop_back();
+		if (!visited.insert(node).second) continue;
+		if (!MaterializeNode(node)) return false;
+		for (size_t i = 0; i < node->size(); ++i) stack.push_back(node->children()[i]);
+	}
+	return true;
+}
+
+inline bool NodeManager::MaterializeNode(Node *node) {
+	// materialized by another thread
+	if (node->Tick != &Node::Materialize) return true;
+	auto it = offsets_.find(node->id());
+	if (it == offsets_.end()) return false;
+
+	size_t offset = it->second;
+	size_t index = Read<uint16_t>(offset);
+	bool commutative = Read<uint8_t>(offset) != 0;
+	uint32_t children_size = Read<uint32_t>(offset);
+	uint32_t params_size = Read<uint32_t>(offset);
+	int32_t leaf_index = Read<int32_t>(offset);
+
+	std::vector<Node *> children(children_size);
+	for (uint32_t i = 0; i < children_size; ++i)
+		children[i] = FindNode(Read<int32_t>(offset));
+	node->SetChildren(children.data(), children_size);
+	node->SetCommutative(commutative);
+	node->SetParams(reinterpret_cast<const double *>(definitions_.data() + offset), params_size);
+	if (leaf_index >= 0) {
+		LeafDefinition &leaf = leaves_[leaf_index];
+		// shared by the nodes of the function
+		if (!leaf.leaf) leaf.leaf = leaf_factory_->Create(leaf.function);
+		node->SetLeaf(leaf.leaf);
+	}
+	else node->SetLeaf(std::shared_ptr<Leaf>());
+	node->Tick = functions_[index];
+	return true;
+}
+
+inline void NodeManager::Define(int id, size_t index, const std::vector<int> &children_ids,
+		const std::shared_ptr<Leaf> &leaf, void *function, const std::vector<double> &params, bool commutative) {
+	// added before the old definition is released, so that a function used by both is kept
+	int32_t leaf_index = leaf || function ? AddLeaf(leaf, function) : -1;
+	ReleaseDefinition(id);
+	offsets_[id] = definitions_.size();
+	Write<uint16_t>(static_cast<uint16_t>(index));
+	Write<uint8_t>(commutative ? 1 : 0);
+	Write<uint32_t>(static_cast<uint32_t>(children_ids.size()));
+	Write<uint32_t>(static_cast<uint32_t>(params.size()));
+	Write<int32_t>(leaf_index);
+	for (int child_id : children_ids) Write<int32_t>(child_id);
+	for (double param : params) Write<double>(param);
+}
+
+inline int32_t NodeManager::AddLeaf(const std::shared_ptr<Leaf> &leaf, void *function) {
+	if (function != NULL) {
+		auto it = function_leaves_.find(function);
+		if (it != function_leaves_.end()) {
+			++leaves_[it->second].references;
+			return it->second;
+		}
+	}
+
+	int32_t leaf_index;
+	if (!free_leaves_.empty()) {
+		leaf_index = free_leaves_.back();
+		free_leaves_.pop_back();
+	}
+	else {
+		leaf_index = static_cast<int32_t>(leaves_.size());
+		leaves_.push_back(LeafDefinition());
+	}
+	LeafDefinition &definition = leaves_[leaf_index];
+	definition.leaf = leaf;
+	definition.function = function;
+	definition.references = 1;
+	if (function != NULL) {
+		leaf_factory_->Retain(function);
+		function_leaves_[function] = leaf_index;
+	}
+	return leaf_index;
+}
+
+inline void NodeManager::ReleaseLeaf(int32_t leaf_index) {
+	LeafDefinition &definition = leaves_[leaf_index];
+	if (--definition.references > 0) return;
+	// the materialized nodes keep their leaf
+	definition.leaf.reset();
+	if (definition.function != NULL) {
+		function_leaves_.erase(definition.function);
+		leaf_factory_->Release(definition.function);
+		definition.function = NULL;
+	}
+	free_leaves_.push_back(leaf_index);
+}
+
+inline void NodeManager::ReleaseDefinition(int id) {
+	auto it = offsets_.find(id);
+	if (it == offsets_.end()) return;
+	size_t offset = it->second;
+	Read<uint16_t>(offset);
+	Read<uint8_t>(offset);
+	Read<uint32_t>(offset);
+	Read<uint32_t>(offset);
+	int32_t leaf_index = Read<int32_t>(offset);
+	if (leaf_index >= 0) ReleaseLeaf(leaf_index);
+}
+
+inline Node *NodeManager::FindNode(int id) {
+	auto it = nodes_.find(id);
+	if (it != nodes_.end()) return it->second;
+	if (offsets_.find(id) == offsets_.end()) return NULL;
+
+	Node *node = new Node(id);
+	node->Tick = &Node::Materialize;
+	nodes_[id] = node;
+	return node;
+}
+
+inline Node *NodeManager::CreateNode(int id, size_t index, const std::vector<int> &children_ids,
+		const std::shared_ptr<Leaf> &leaf, const std::vector<double> &params, bool commutative) {
+	if (!IsNodeDataValid(index, children_ids, leaf != NULL, params, commutative))
+		return NULL;
+
+	Node *node = new Node(id);
+	node->Tick = functions_[index];
+	node->SetLeaf(leaf);
+	node->SetParams(params.data(), params.size());
+
+	size_t size = children_ids.size();
+	Node **children = new Node *[size];
+	for (size_t i = 0; i < size; ++i)
+		children[i] = FindNode(children_ids[i]);
+	node->SetChildren(children, size);
+	node->SetCommutative(commutative);
+
+	delete[] children;
+	children = NULL;
+	return node;
+}
+
+inline bool NodeManager::IsNodeDataValid(size_t index, const std::vector<int> &children_ids, bool has_leaf,
+		const std::vector<double> &params, bool commutative) {
+	if (index >= functions_.size()) return false;
+	if (IsLeafFunction(functions_[index]) && !has_leaf) return false;
+	if (params.size() < ParamsSize(functions_[index])) return false;
+	if (commutative && !IsReorderable(functions_[index])) return false;
+	for (size_t i = 0; i < children_ids.size(); ++i) {
+		auto pointer = nodes_.find(children_ids[i]);
+		if ((pointer == nodes_.end() || !pointer->second) && offsets_.find(children_ids[i]) == offsets_.end())
+			return false;
+	}
+	return true;
+}
+
+inline void NodeManager::InitFunctions() {
+	functions_ = {
+		&Node::TickLeaf,
+		&Node::TickNode,
+		&Node::RunUntilSuccess,
+		&Node::RunUntilFail,
+		&Node::MemRunUntilSuccess,
+		&Node::MemRunUntilFail,
+		&Node::ReportSuccess,
+		&Node::ReportFailure,
+		&Node::RevertStatus,
+		&Node::TickAsyncLeaf,
+		&Node::Repeat,
+		&Node::Retry,
+		&Node::Timeout,
+		&Node::Cooldown,
+		&Node::RateLimit,
+		&Node::CompareValue,
+		&Node::CompareColumns,
+		&Node::TickBatchLeaf,
+	};
+	function_names_ = {
+		"tick_leaf",
+		"tick_node",
+		"run_until_success",
+		"run_until_fail",
+		"mem_run_until_success",
+		"mem_run_until_fail",
+		"report_success",
+		"report_failure",
+		"revert_status",
+		"tick_async_leaf",
+		"repeat",
+		"retry",
+		"timeout",
+		"cooldown",
+		"rate_limit",
+		"compare_value",
+		"compare_columns",
+		"tick_batch_leaf",
+	};
+}
+
+#endif // !NODE_MANAGER_H
@@ -1,12 +1,12 @@
-#pragma once
-#ifndef PROFILE_DATA_H
-#define PROFILE_DATA_H
-
-#include <ctime>
-
-struct ProfileData {
-	unsigned int calls;
-	unsigned long clocks;
-};
-
-#endif // !PROFILE_DATA_H
+#pragma once
+#ifndef PROFILE_DATA_H
+#define PROFILE_DATA_H
+
+#include <ctime>
+
+struct ProfileData {
+	unsigned int calls;
+	unsigned long clocks;
+};
+
+#endif // !PROFILE_DATA_H
@@ -1,9 +1,9 @@
-#pragma once
-#ifndef BEHAVIOR_TREE_H
-#define BEHAVIOR_TREE_H
-
-#include "global.h"
-
-void InitModule(const char *module_name);
-
-#endif // !BEHAVIOR_TREE_H
+#pragma once
+#ifndef BEHAVIOR_TREE_H
+#define BEHAVIOR_TREE_H
+
+#include "python/py_global.h"
+
+void InitModule(const char *module_name);
+
+#endif // !BEHAVIOR_TREE_H
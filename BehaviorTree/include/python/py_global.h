@@ -0,0 +1,18 @@
+#pragma once
+#ifndef PY_GLOBAL_H
+#define PY_GLOBAL_H
+
+#ifdef _DEBUG
+#undef _DEBUG
+#define DEBUG_WAS_DEFINED
+#endif // _DEBUG
+
+#include "Python.h"
+
+#ifdef DEBUG_WAS_DEFINED
+#define _DEBUG
+#endif // DEBUG_WAS_DEFINED
+
+#include "global.h"
+
+#endif // !PY_GLOBAL_H
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef PY_LEAF_H
+#define PY_LEAF_H
+
+#include "python/py_global.h"
+#include "leaf.h"
+#include <string>
+#include <memory>
+
+// A leaf calling a Python function with the arguments tuple of Root.tick.
+// Started as an async leaf, the function may return a future (an object with add_done_callback and result)
+// whose result is pushed to the completion queue by a native done callback.
+// Ticked as a batch leaf, the function is called with the list of the arguments tuples of the roots,
+// and returns the list (or an int32 buffer, e.g. array.array('i')) of their statuses.
+class PyLeaf : public Leaf {
+public:
+	DISABLE_COPY_AND_ASSIGN(PyLeaf);
+
+	explicit PyLeaf(PyObject *function);
+	~PyLeaf();
+	int Tick(void *args) override;
+	int Start(void *args, CompletionQueue::Ticket &ticket) override;
+	void TickBatch(void **args, int *statuses, size_t size) override;
+	const char *name() const override { return name_.c_str(); }
+
+private:
+	// returns a new reference, NULL if the function raised
+	PyObject *Call(void *args);
+	// registers a done callback on the future, returns 0 on failure
+	static CompletionQueue::Ticket Watch(PyObject *future);
+	// returns false and sets the error if result is not size statuses
+	static bool ReadStatuses(PyObject *result, int *statuses, size_t size);
+
+private:
+	PyObject *function_;
+	std::string name_;
+};
+
+// Builds the PyLeaf of the Python functions passed to add_node.
+class PyLeafFactory : public LeafFactory {
+public:
+	void Retain(void *function) override { Py_INCREF(static_cast<PyObject *>(function)); }
+	void Release(void *function) override { Py_DECREF(static_cast<PyObject *>(function)); }
+	std::shared_ptr<Leaf> Create(void *function) override {
+		return std::make_shared<PyLeaf>(static_cast<PyObject *>(function));
+	}
+};
+
+#endif // !PY_LEAF_H
@@ -0,0 +1,258 @@
+#pragma once
+#ifndef PYROOT_H
+#define PYROOT_H
+
+#include "python/py_global.h"
+#include "structmember.h"
+#include "engine.h"
+#include "tick_log.h"
+#include "allocation_tracker.h"
+
+typedef struct {
+	PyObject_HEAD
+	bool can_tick;
+	int tick_result;
+	Root *root;
+} PyRoot;
+
+// binds the root to the node of its node_id
+static void BindPyRoot(PyRoot *self) {
+	self->can_tick = BindRoot(*self->root, self->root->node_id);
+	self->tick_result = 0;
+}
+
+static void RootDealloc(PyRoot *self) {
+	CancelTickets(*self->root);
+
+	self->can_tick = false;
+	self->tick_result = 0;
+	delete self->root;
+	self->root = NULL;
+	self->ob_type->tp_free((PyObject*)self);
+}
+
+static PyObject *RootNew(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+	TRACK_API_CALL("Root.__new__");
+	PyRoot *self = (PyRoot *)type->tp_alloc(type, 0);
+	if (self != NULL) {
+		self->can_tick = false;
+		self->tick_result = 0;
+		self->root = new Root();
+	}
+	return (PyObject *)self;
+}
+
+static int RootInit(PyRoot *self, PyObject *args, PyObject *kwds) {
+	TRACK_API_CALL("Root.__init__");
+	static char *kwlist[] = {"node_id", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "|i", kwlist, &self->root->node_id)) return -1;
+	BindPyRoot(self);
+	return 0;
+}
+
+static PyObject *RootTick(PyRoot *self, PyObject *args) {
+	TRACK_API_CALL("Root.tick");
+	self->tick_result = self->can_tick ? TickRoot(*self->root, args) : 0;
+	Py_RETURN_NONE;
+}
+
+static PyObject *RootStartRecording(PyRoot *self, PyObject *args, PyObject *kwds) {
+	TRACK_API_CALL("Root.start_recording");
+	int latency = 0;
+	static char *kwlist[] = {"latency", NULL};
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "|i", kwlist, &latency)) return NULL;
+	// the log starts with a whole tick, so a yielded tick is not resumed
+	self->root->ResetTraversal();
+	delete self->root->tick_log;
+	self->root->tick_log = new TickLog(latency != 0);
+	Py_RETURN_NONE;
+}
+
+static PyObject *RootStopRecording(PyRoot *self, PyObject *args) {
+	TRACK_API_CALL("Root.stop_recording");
+	TickLog *tick_log = self->root->tick_log;
+	if (tick_log == NULL || !tick_log->recording()) {
+		PyErr_SetString(PyExc_RuntimeError, "The root is not recording");
+		return NULL;
+	}
+	PyObject *data = PyString_FromStringAndSize(tick_log->data().c_str(), tick_log->data().length());
+	delete tick_log;
+	self->root->tick_log = NULL;
+	return data;
+}
+
+static PyObject *RootStartReplay(PyRoot *self, PyObject *args) {
+	TRACK_API_CALL("Root.start_replay");
+	const char *data;
+	int size;
+	if (!PyArg_ParseTuple(args, "s#", &data, &size)) return NULL;
+	TickLog *tick_log = new TickLog(data, size);
+	if (!tick_log->valid()) {
+		delete tick_log;
+		PyErr_SetString(PyExc_ValueError, "Invalid tick log");
+		return NULL;
+	}
+	self->root->ResetTraversal();
+	delete self->root->tick_log;
+	self->root->tick_log = tick_log;
+	Py_RETURN_NONE;
+}
+
+static PyObject *RootStopReplay(PyRoot *self, PyObject *args) {
+	TRACK_API_CALL("Root.stop_replay");
+	if (self->root->tick_log && self->root->tick_log->mode() == TickLog::REPLAY) {
+		delete self->root->tick_log;
+		self->root->tick_log = NULL;
+	}
+	Py_RETURN_NONE;
+}
+
+static PyMethodDef root_methods[] = {
+	{ "tick", (PyCFunction)RootTick, METH_VARARGS, "tick root" },
+	{ "start_recording", (PyCFunction)RootStartRecording, METH_VARARGS | METH_KEYWORDS,
+		"start_recording(latency=False) -- record the status of Python leaves per tick" },
+	{ "stop_recording", (PyCFunction)RootStopRecording, METH_NOARGS, "stop_recording() -- return the tick log" },
+	{ "start_replay", (PyCFunction)RootStartReplay, METH_VARARGS,
+		"start_replay(log) -- replace Python leaves with the results in the tick log" },
+	{ "stop_replay", (PyCFunction)RootStopReplay, METH_NOARGS, "stop_replay()" },
+	{ NULL, NULL, 0, NULL },
+};
+
+static PyObject *RootGetNodeId(PyRoot *self, void *closure) {
+	return PyInt_FromLong(self->root->node_id);
+}
+
+static int RootSetNodeId(PyRoot *self, PyObject *value, void *closure) {
+	int node_id = PyInt_AsLong(value);
+	if (PyErr_Occurred()) return -1;
+
+	self->root->node_id = node_id;
+	self->root->ResetTraversal();
+	BindPyRoot(self);
+	return 0;
+}
+
+static PyObject *RootGetCanTick(PyRoot *self, void *closure) {
+	return PyBool_FromLong(self->can_tick);
+}
+
+static PyObject *RootGetTickResult(PyRoot *self, void *closure) {
+	return PyInt_FromLong(self->tick_result);
+}
+
+static PyObject *RootGetDebug(PyRoot *self, void *closure) {
+	return PyBool_FromLong(self->root->debug);
+}
+
+static int RootSetDebug(PyRoot *self, PyObject *value, void *closure) {
+	int debug = PyObject_IsTrue(value);
+	if (debug < 0) return -1;
+	self->root->debug = (debug != 0);
+	return 0;
+}
+
+static PyObject *RootGetRecording(PyRoot *self, void *closure) {
+	return PyBool_FromLong(self->root->tick_log && self->root->tick_log->recording());
+}
+
+static PyObject *RootGetReplaying(PyRoot *self, void *closure) {
+	return PyBool_FromLong(self->root->tick_log && self->root->tick_log->replaying());
+}
+
+static PyObject *RootGetTimeBudget(PyRoot *self, void *closure) {
+	return PyFloat_FromDouble(self->root->time_budget);
+}
+
+static int RootSetTimeBudget(PyRoot *self, PyObject *value, void *closure) {
+	double time_budget = PyFloat_AsDouble(value);
+	if (PyErr_Occurred()) return -1;
+	self->root->time_budget = time_budget > 0 ? time_budget : 0;
+	return 0;
+}
+
+static PyObject *RootGetSlot(PyRoot *self, void *closure) {
+	return PyInt_FromLong(self->root->slot);
+}
+
+static int RootSetSlot(PyRoot *self, PyObject *value, void *closure) {
+	int slot = PyInt_AsLong(value);
+	if (PyErr_Occurred()) return -1;
+	self->root->slot = slot < 0 ? -1 : slot;
+	return 0;
+}
+
+static PyObject *RootGetYielded(PyRoot *self, void *closure) {
+	return PyBool_FromLong(self->root->resuming());
+}
+
+static PyObject *RootGetTickAllocations(PyRoot *self, void *closure) {
+	AllocationStats &stats = self->root->tick_allocations;
+	return Py_BuildValue("(KK)", (unsigned PY_LONG_LONG)stats.allocations, (unsigned PY_LONG_LONG)stats.bytes);
+}
+
+static PyObject *RootGetAllocations(PyRoot *self, void *closure) {
+	AllocationStats &stats = self->root->allocations;
+	return Py_BuildValue("(KK)", (unsigned PY_LONG_LONG)stats.allocations, (unsigned PY_LONG_LONG)stats.bytes);
+}
+
+static PyGetSetDef root_getseters[] = {
+	{ "node_id", (getter)RootGetNodeId, (setter)RootSetNodeId, "node id", NULL },
+	{ "can_tick", (getter)RootGetCanTick, NULL, "can tick", NULL },
+	{ "tick_result", (getter)RootGetTickResult, NULL, "tick result", NULL },
+	{ "debug", (getter)RootGetDebug, (setter)RootSetDebug, "debug", NULL },
+	{ "recording", (getter)RootGetRecording, NULL, "recording", NULL },
+	{ "replaying", (getter)RootGetReplaying, NULL, "replaying", NULL },
+	{ "time_budget", (getter)RootGetTimeBudget, (setter)RootSetTimeBudget,
+		"seconds a tick may take before the traversal yields, 0 means unlimited", NULL },
+	{ "slot", (getter)RootGetSlot, (setter)RootSetSlot, "row of the agent in the columns, -1 if none", NULL },
+	{ "yielded", (getter)RootGetYielded, NULL, "the last tick yielded and the next tick resumes it", NULL },
+	{ "tick_allocations", (getter)RootGetTickAllocations, NULL,
+		"(allocations, bytes) of the heap allocations of the last tick, TRACK_ALLOCATIONS builds only", NULL },
+	{ "allocations", (getter)RootGetAllocations, NULL,
+		"(allocations, bytes) of the heap allocations of all the ticks, TRACK_ALLOCATIONS builds only", NULL },
+	{ NULL },
+};
+
+static PyTypeObject RootType = {
+	PyObject_HEAD_INIT(NULL)
+	0,                         /*ob_size*/
+	"behavior_tree.Root",      /*tp_name*/
+	sizeof(PyRoot),            /*tp_basicsize*/
+	0,                         /*tp_itemsize*/
+	(destructor)RootDealloc,   /*tp_dealloc*/
+	0,                         /*tp_print*/
+	0,                         /*tp_getattr*/
+	0,                         /*tp_setattr*/
+	0,                         /*tp_compare*/
+	0,                         /*tp_repr*/
+	0,                         /*tp_as_number*/
+	0,                         /*tp_as_sequence*/
+	0,                         /*tp_as_mapping*/
+	0,                         /*tp_hash */
+	0,                         /*tp_call*/
+	0,                         /*tp_str*/
+	0,                         /*tp_getattro*/
+	0,                         /*tp_setattro*/
+	0,                         /*tp_as_buffer*/
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE, /*tp_flags*/
+	"Root objects",            /* tp_doc */
+	0,                         /* tp_traverse */
+	0,                         /* tp_clear */
+	0,                         /* tp_richcompare */
+	0,                         /* tp_weaklistoffset */
+	0,                         /* tp_iter */
+	0,                         /* tp_iternext */
+	root_methods,              /* tp_methods */
+	0,                         /* tp_members */
+	root_getseters,            /* tp_getset */
+	0,                         /* tp_base */
+	0,                         /* tp_dict */
+	0,                         /* tp_descr_get */
+	0,                         /* tp_descr_set */
+	0,                         /* tp_dictoffset */
+	(initproc)RootInit,        /* tp_init */
+	0,                         /* tp_alloc */
+	RootNew,                   /* tp_new */
+};
+
+#endif // !PYROOT_H
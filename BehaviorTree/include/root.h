@@ -1,28 +1,143 @@
-#pragma once
-#ifndef ROOT_H
-#define ROOT_H
-
-#include "global.h"
-#include <unordered_map>
-
-class Node;
-struct NodeData;
-typedef std::unordered_map<int, NodeData> TreeData;
-
-struct Root {
-	Root() : node_id(0), node(NULL), tree_data(new TreeData()), debug(false) {}
-	~Root() {
-		node_id = 0;
-		node = NULL;
-		delete tree_data;
-		tree_data = NULL;
-		debug = false;
-	}
-
-	int node_id;
-	Node *node;
-	TreeData *tree_data;
-	bool debug;
-};
-
-#endif // !ROOT_H
+#pragma once
+#ifndef ROOT_H
+#define ROOT_H
+
+#include "global.h"
+#include "tick_log.h"
+#include "allocation_tracker.h"
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+
+class Node;
+class Batch;
+struct NodeData;
+typedef std::unordered_map<int, NodeData> TreeData;
+
+// the child a composite node was about to tick when the traversal yielded
+struct ResumePoint {
+	int node_id;
+	size_t child_index;
+	// the order of the children of a commutative node, see ChildOrder::generation
+	unsigned int generation;
+};
+
+struct Root {
+	Root() :
+			node_id(0),
+			node(NULL),
+			tree_data(new TreeData()),
+			debug(false),
+			tick_log(NULL),
+			time_budget(0),
+			deadline(0),
+			budget_left(0),
+			tick_count(0),
+			slot(-1),
+			batch(NULL),
+			waiting_leaf(NULL),
+			done_leaf(NULL),
+			leaf_status(0) {}
+	~Root() {
+		node_id = 0;
+		node = NULL;
+		delete tree_data;
+		tree_data = NULL;
+		debug = false;
+		delete tick_log;
+		tick_log = NULL;
+		time_budget = 0;
+		deadline = 0;
+		budget_left = 0;
+		tick_count = 0;
+		slot = -1;
+		batch = NULL;
+		waiting_leaf = NULL;
+		done_leaf = NULL;
+		leaf_status = 0;
+	}
+	bool resuming() const { return !resume_stack.empty() || done_leaf != NULL; }
+	void BeginTick();
+	void EndTick(int status);
+	void ResetTraversal() { resume_stack.clear(); suspend_stack.clear(); }
+	bool ShouldYield() const { return deadline != 0 && get_monotonic_time() >= deadline; }
+	// returns the index of the child to resume from, 0 if the node is not suspended
+	// or its children have been reordered since then
+	size_t Resume(int id, unsigned int generation = 0);
+	// called when the child a composite node resumed from returns: the traversal has left the path
+	// of the yielded tick, so the resume points and the batch leaf status not reached are stale
+	void EndResume() { resume_stack.clear(); done_leaf = NULL; }
+	// true if the yielded tick is resumed from the node
+	bool suspended_in(int id) const { return !resume_stack.empty() && resume_stack.back().node_id == id; }
+	int Suspend(int id, size_t child_index, unsigned int generation = 0);
+
+	int node_id;
+	Node *node;
+	TreeData *tree_data;
+	bool debug;
+	TickLog *tick_log;
+	// seconds a tick may take before the traversal yields, 0 means unlimited
+	double time_budget;
+	double deadline;
+	// the budget a tick waiting on a batch leaf has left, the resumed tick continues with it
+	double budget_left;
+	// the resume points of the last yielded tick, the outermost node on the top
+	std::vector<ResumePoint> resume_stack;
+	// the resume points of the current tick, pushed from the innermost node
+	std::vector<ResumePoint> suspend_stack;
+	// serial number of the current tick, never 0
+	// a resumed tick continues the one which yielded and keeps its number
+	unsigned int tick_count;
+	// row of the agent in the columns of the column store, -1 if none
+	int slot;
+	// the batch the root is ticked in, NULL if it is ticked alone
+	Batch *batch;
+	// the batch leaf the root waits on in a batch tick
+	const Node *waiting_leaf;
+	// the batch leaf which has been ticked for the root, and its status for the resumed tick
+	const Node *done_leaf;
+	int leaf_status;
+	// heap allocations of the last tick and of all the ticks, counted in TRACK_ALLOCATIONS builds
+	AllocationStats tick_allocations;
+	AllocationStats allocations;
+};
+
+inline void Root::BeginTick() {
+	// the time other roots and the batch leaf take is not charged to the root
+	if (done_leaf != NULL) deadline = time_budget > 0 ? get_monotonic_time() + budget_left : 0;
+	else deadline = time_budget > 0 ? get_monotonic_time() + time_budget : 0;
+	if (resuming()) return;
+	if (++tick_count == 0) ++tick_count;
+}
+
+inline void Root::EndTick(int status) {
+	// drop the resume points that were not reached again
+	resume_stack.clear();
+	if (status == YIELDED) resume_stack.swap(suspend_stack);
+	else suspend_stack.clear();
+	budget_left = waiting_leaf != NULL && deadline != 0 ? std::max(deadline - get_monotonic_time(), 0.0) : 0;
+	deadline = 0;
+}
+
+inline size_t Root::Resume(int id, unsigned int generation) {
+	if (resume_stack.empty()) return 0;
+	// the node is not on the path of the yielded tick
+	if (resume_stack.back().node_id != id) {
+		EndResume();
+		return 0;
+	}
+	ResumePoint point = resume_stack.back();
+	resume_stack.pop_back();
+	if (point.generation == generation) return point.child_index;
+	// the node restarts, so the resume points of its descendants are stale
+	EndResume();
+	return 0;
+}
+
+inline int Root::Suspend(int id, size_t child_index, unsigned int generation) {
+	ResumePoint point = { id, child_index, generation };
+	suspend_stack.push_back(point);
+	return YIELDED;
+}
+
+#endif // !ROOT_H
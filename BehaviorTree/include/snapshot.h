@@ -0,0 +1,151 @@
+#pragma once
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "global.h"
+#include "root.h"
+#include "node_data.h"
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+// Serializes the running state of roots, so that they can be restored in another process.
+// format: [magic "BTSN"][version][snapshot_time][roots_size]
+// [node_id][debug][slot][time_budget][tick_count]
+// [resume_size][node_id][child_index]...
+// [data_size][node_id][child_index][counter][timestamp]...
+// [node_id][debug]... (next root)
+// The timestamps are relative to snapshot_time, and the futures of async leaves are not kept.
+class Snapshot {
+public:
+	static const uint32_t VERSION = 1;
+	DISABLE_COPY_AND_ASSIGN(Snapshot);
+
+	// starts writing
+	explicit Snapshot(size_t roots_size);
+	// starts reading, valid() is false if the header is malformed
+	Snapshot(const char *data, size_t size);
+
+	bool valid() const { return valid_; }
+	uint32_t roots_size() const { return roots_size_; }
+	const std::string &data() const { return data_; }
+
+	void WriteRoot(const Root &root);
+	// returns false if the data is truncated
+	bool ReadRoot(Root &root);
+
+private:
+	template <typename T> void Write(T value) {
+		data_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+	template <typename T> bool Read(T &value) {
+		if (position_ + sizeof(value) > size_) return false;
+		memcpy(&value, input_ + position_, sizeof(value));
+		position_ += sizeof(value);
+		return true;
+	}
+
+private:
+	bool valid_;
+	uint32_t roots_size_;
+	double snapshot_time_;
+	double restore_time_;
+	std::string data_;
+	const char *input_;
+	size_t size_;
+	size_t position_;
+};
+
+inline Snapshot::Snapshot(size_t roots_size) :
+		valid_(true),
+		roots_size_(static_cast<uint32_t>(roots_size)),
+		snapshot_time_(get_monotonic_time()),
+		restore_time_(0),
+		input_(NULL),
+		size_(0),
+		position_(0) {
+	data_.append("BTSN", 4);
+	Write<uint32_t>(VERSION);
+	Write<double>(snapshot_time_);
+	Write<uint32_t>(roots_size_);
+}
+
+inline Snapshot::Snapshot(const char *data, size_t size) :
+		valid_(false),
+		roots_size_(0),
+		snapshot_time_(0),
+		restore_time_(get_monotonic_time()),
+		input_(data),
+		size_(size),
+		position_(0) {
+	uint32_t version;
+	if (size < 4 || memcmp(data, "BTSN", 4) != 0) return;
+	position_ = 4;
+	if (!Read(version) || version != VERSION || !Read(snapshot_time_) || !Read(roots_size_)) return;
+	valid_ = true;
+}
+
+inline void Snapshot::WriteRoot(const Root &root) {
+	Write<int32_t>(root.node_id);
+	Write<uint8_t>(root.debug);
+	Write<int32_t>(root.slot);
+	Write<double>(root.time_budget);
+	Write<uint32_t>(root.tick_count);
+
+	Write<uint32_t>(static_cast<uint32_t>(root.resume_stack.size()));
+	for (auto &point : root.resume_stack) {
+		// the order of the children of a commutative node is not kept, so a reordered node restarts
+		Write<int32_t>(point.node_id);
+		Write<uint32_t>(static_cast<uint32_t>(point.generation == 0 ? point.child_index : 0));
+	}
+
+	Write<uint32_t>(static_cast<uint32_t>(root.tree_data->size()));
+	for (auto &pair : *root.tree_data) {
+		const NodeData &node_data = pair.second;
+		Write<int32_t>(pair.first);
+		Write<uint32_t>(static_cast<uint32_t>(node_data.child_index));
+		Write<uint32_t>(node_data.counter);
+		Write<double>(node_data.timestamp != 0 ? node_data.timestamp - snapshot_time_ : 0);
+	}
+}
+
+inline bool Snapshot::ReadRoot(Root &root) {
+	int32_t node_id, slot;
+	uint8_t debug;
+	double time_budget;
+	uint32_t tick_count, size;
+	if (!Read(node_id) || !Read(debug) || !Read(slot) || !Read(time_budget) || !Read(tick_count))
+		return false;
+	root.node_id = node_id;
+	root.debug = (debug != 0);
+	root.slot = slot;
+	root.time_budget = time_budget;
+	root.tick_count = tick_count;
+
+	root.ResetTraversal();
+	if (!Read(size)) return false;
+	for (uint32_t i = 0; i < size; ++i) {
+		int32_t id;
+		uint32_t child_index;
+		if (!Read(id) || !Read(child_index)) return false;
+		ResumePoint point = { id, child_index, 0 };
+		root.resume_stack.push_back(point);
+	}
+
+	root.tree_data->clear();
+	if (!Read(size)) return false;
+	root.tree_data->reserve(size);
+	for (uint32_t i = 0; i < size; ++i) {
+		int32_t id;
+		uint32_t child_index, counter;
+		double timestamp;
+		if (!Read(id) || !Read(child_index) || !Read(counter) || !Read(timestamp)) return false;
+		NodeData &node_data = (*root.tree_data)[id];
+		node_data.child_index = child_index;
+		node_data.counter = counter;
+		node_data.timestamp = timestamp != 0 ? timestamp + restore_time_ : 0;
+	}
+	return true;
+}
+
+#endif // !SNAPSHOT_H
@@ -0,0 +1,137 @@
+#pragma once
+#ifndef TICK_LOG_H
+#define TICK_LOG_H
+
+#include "global.h"
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+// Records the status returned by every leaf of a root per tick, or
+// replays such a record in place of the leaves.
+// The time read by the time-dependent decorators is recorded and replayed too.
+// format: [magic "BTTL"][version][flags]
+// [TICK][root_node_id][LEAF][node_id][status][latency_us]...[TIME][node_id][time]...[TICK][root_node_id]...
+// latency_us is present only when the flags has LATENCY.
+class TickLog {
+public:
+	enum Mode { RECORD, REPLAY };
+	enum Flag { LATENCY = 0x1 };
+	enum Record { TICK = 'T', LEAF = 'L', TIME = 'C' };
+	static const uint8_t VERSION = 2;
+	DISABLE_COPY_AND_ASSIGN(TickLog);
+
+	// starts an empty record
+	explicit TickLog(bool latency);
+	// starts a replay, valid() is false if the data is malformed
+	TickLog(const char *data, size_t size);
+
+	Mode mode() const { return mode_; }
+	bool recording() const { return mode_ == RECORD; }
+	// true until the record is exhausted or the traversal diverges from it
+	bool replaying() const { return mode_ == REPLAY && !finished_; }
+	bool latency() const { return (flags_ & LATENCY) != 0; }
+	bool valid() const { return valid_; }
+	const std::string &data() const { return data_; }
+
+	// returns false if there is no more tick to replay
+	bool BeginTick(int root_node_id);
+	void Record(int node_id, int status, double start_time);
+	int Replay(int node_id);
+	void RecordTime(int node_id, double time);
+	// returns the recorded time, the current time if the traversal diverges
+	double ReplayTime(int node_id);
+
+private:
+	template <typename T> void Write(T value) {
+		data_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+	template <typename T> bool Read(T &value) {
+		if (position_ + sizeof(value) > data_.size()) return false;
+		memcpy(&value, data_.data() + position_, sizeof(value));
+		position_ += sizeof(value);
+		return true;
+	}
+
+private:
+	Mode mode_;
+	uint8_t flags_;
+	bool valid_;
+	bool finished_;
+	std::string data_;
+	size_t position_;
+};
+
+inline TickLog::TickLog(bool latency) :
+		mode_(RECORD), flags_(latency ? LATENCY : 0), valid_(true), finished_(false), position_(0) {
+	data_.append("BTTL", 4);
+	Write<uint8_t>(VERSION);
+	Write<uint8_t>(flags_);
+}
+
+inline TickLog::TickLog(const char *data, size_t size) :
+		mode_(REPLAY), flags_(0), valid_(false), finished_(false), data_(data, size), position_(0) {
+	uint8_t version;
+	if (size < 4 || memcmp(data, "BTTL", 4) != 0) return;
+	position_ = 4;
+	if (!Read(version) || version != VERSION || !Read(flags_)) return;
+	valid_ = true;
+}
+
+inline bool TickLog::BeginTick(int root_node_id) {
+	if (mode_ == RECORD) {
+		Write<uint8_t>(TICK);
+		Write<int32_t>(root_node_id);
+		return true;
+	}
+
+	uint8_t type;
+	int32_t node_id;
+	if (finished_ || !Read(type) || type != TICK || !Read(node_id) || node_id != root_node_id) {
+		finished_ = true;
+		return false;
+	}
+	return true;
+}
+
+inline void TickLog::Record(int node_id, int status, double start_time) {
+	Write<uint8_t>(LEAF);
+	Write<int32_t>(node_id);
+	Write<int8_t>(status);
+	if (latency()) {
+		double latency_us = (get_monotonic_time() - start_time) * 1e6;
+		Write<uint32_t>(latency_us < UINT32_MAX ? static_cast<uint32_t>(latency_us) : UINT32_MAX);
+	}
+}
+
+inline int TickLog::Replay(int node_id) {
+	uint8_t type;
+	int32_t recorded_id;
+	int8_t status;
+	uint32_t latency_us;
+	if (finished_ || !Read(type) || type != LEAF || !Read(recorded_id) || recorded_id != node_id ||
+			!Read(status) || (latency() && !Read(latency_us))) {
+		finished_ = true;
+		return ERROR;
+	}
+	return status;
+}
+
+inline void TickLog::RecordTime(int node_id, double time) {
+	Write<uint8_t>(TIME);
+	Write<int32_t>(node_id);
+	Write<double>(time);
+}
+
+inline double TickLog::ReplayTime(int node_id) {
+	uint8_t type;
+	int32_t recorded_id;
+	double time;
+	if (finished_ || !Read(type) || type != TIME || !Read(recorded_id) || recorded_id != node_id || !Read(time)) {
+		finished_ = true;
+		return get_monotonic_time();
+	}
+	return time;
+}
+
+#endif // !TICK_LOG_H
@@ -0,0 +1,63 @@
+#include "allocation_tracker.h"
+
+#ifdef TRACK_ALLOCATIONS
+#include <new>
+#include <cstdlib>
+
+// plain counters, so that the thread local storage needs no dynamic initialization
+static thread_local uint64_t thread_allocations = 0;
+static thread_local uint64_t thread_bytes = 0;
+
+static void *Allocate(size_t size) {
+	++thread_allocations;
+	thread_bytes += size;
+	return malloc(size != 0 ? size : 1);
+}
+
+void *operator new(size_t size) {
+	void *pointer = Allocate(size);
+	if (pointer == NULL) throw std::bad_alloc();
+	return pointer;
+}
+
+void *operator new[](size_t size) {
+	void *pointer = Allocate(size);
+	if (pointer == NULL) throw std::bad_alloc();
+	return pointer;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+	return Allocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+	return Allocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+	free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+	free(pointer);
+}
+
+void operator delete(void *pointer, const std::nothrow_t &) noexcept {
+	free(pointer);
+}
+
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept {
+	free(pointer);
+}
+
+AllocationStats get_thread_allocations() {
+	AllocationStats stats;
+	stats.allocations = thread_allocations;
+	stats.bytes = thread_bytes;
+	return stats;
+}
+#else
+AllocationStats get_thread_allocations() {
+	return AllocationStats();
+}
+#endif // TRACK_ALLOCATIONS
@@ -0,0 +1,113 @@
+#include "engine.h"
+#include "batch.h"
+#include "node_data.h"
+#include "completion_queue.h"
+#include "profile/profiler.h"
+#include "allocation_tracker.h"
+#include <vector>
+#include <memory>
+
+// the batches of the finished calls of TickBatch, reused so that a batch tick doesn't allocate
+// A call nested in a leaf takes another batch.
+static thread_local std::vector<std::unique_ptr<Batch> > free_batches;
+
+bool BindRoot(Root &root, int node_id) {
+	root.node_id = node_id;
+	root.node = NodeManager::Instance().GetNode(node_id);
+	return root.node != NULL;
+}
+
+int TickRoot(Root &root, void *args) {
+	if (root.node == NULL) return 0;
+
+	// a resumed tick continues the leaves of the yielded one in the tick log
+	if (root.tick_log && !root.resuming() && !root.tick_log->BeginTick(root.node_id))
+		return 0;
+#ifdef TRACK_ALLOCATIONS
+	AllocationScope scope;
+#endif // TRACK_ALLOCATIONS
+	root.BeginTick();
+
+	int status;
+#ifndef PROFILE_TICK
+	status = (root.node->*(root.node->Tick))(args, root.tree_data);
+#else
+	Profiler &profiler = Profiler::Instance();
+	if (!profiler.enable()) {
+		status = root.node->ProfileTick(args, root.tree_data);
+	}
+	else {
+		profiler.Start(root.node_id);
+		status = root.node->ProfileTick(args, root.tree_data);
+		profiler.End();
+	}
+#endif // !PROFILE_TICK
+
+	root.EndTick(status);
+#ifdef TRACK_ALLOCATIONS
+	root.tick_allocations = scope.Elapsed();
+	root.allocations += root.tick_allocations;
+#endif // TRACK_ALLOCATIONS
+	return status;
+}
+
+void TickBatch(Root **roots, void **args, int *statuses, size_t size) {
+	int min_slot = -1, max_slot = -1;
+	for (size_t i = 0; i < size; ++i) {
+		int slot = roots[i]->slot;
+		if (slot < 0) continue;
+		if (min_slot < 0 || slot < min_slot) min_slot = slot;
+		if (slot > max_slot) max_slot = slot;
+	}
+
+	std::unique_ptr<Batch> batch_holder;
+	if (free_batches.empty()) batch_holder.reset(new Batch());
+	else {
+		batch_holder = std::move(free_batches.back());
+		free_batches.pop_back();
+	}
+	Batch &batch = *batch_holder;
+	batch.Begin(min_slot, max_slot);
+	for (size_t i = 0; i < size; ++i) {
+		// a root listed more than once is ticked once, and a root ticked by an outer call is not ticked
+		if (roots[i]->batch != NULL) {
+			statuses[i] = 0;
+			continue;
+		}
+		roots[i]->batch = &batch;
+		statuses[i] = TickRoot(*roots[i], args[i]);
+	}
+	// the roots waiting on batch leaves resume once the leaves are ticked, until no root waits
+	while (batch.TickLeaves()) {
+		for (size_t i = 0; i < size; ++i) {
+			if (roots[i]->done_leaf == NULL) continue;
+			statuses[i] = TickRoot(*roots[i], args[i]);
+			roots[i]->done_leaf = NULL;
+			--Batch::suspended_roots();
+		}
+	}
+	for (size_t i = 0; i < size; ++i) {
+		if (roots[i]->batch == &batch) {
+			roots[i]->batch = NULL;
+			continue;
+		}
+		if (roots[i]->batch != NULL) continue;
+		for (size_t j = 0; j < i; ++j) {
+			if (roots[j] == roots[i]) {
+				statuses[i] = statuses[j];
+				break;
+			}
+		}
+	}
+	free_batches.push_back(std::move(batch_holder));
+}
+
+void CancelTickets(Root &root) {
+	auto &queue = CompletionQueue::Instance();
+	for (auto &pair : *root.tree_data) {
+		if (pair.second.ticket) {
+			queue.Cancel(pair.second.ticket);
+			pair.second.ticket = 0;
+		}
+	}
+}
@@ -1,8 +1,33 @@
-#include "global.h"
-#include <ctime>
-
-void get_timestamp(char *buffer, size_t size) {
-	time_t timestamp = time(NULL);
-	struct tm *time_info = localtime(&timestamp);
-	strftime(buffer, sizeof(char *) * size, "%Y-%m-%d %H:%M:%S", time_info);
-}
+#include "global.h"
+#include <ctime>
+#include <chrono>
+#include <cstdio>
+#include <cstdarg>
+
+static void WriteStdout(const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	vfprintf(stdout, format, args);
+	va_end(args);
+}
+
+static void WriteStderr(const char *format, ...) {
+	va_list args;
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+}
+
+TraceWriter trace_stdout = WriteStdout;
+TraceWriter trace_stderr = WriteStderr;
+
+void get_timestamp(char *buffer, size_t size) {
+	time_t timestamp = time(NULL);
+	struct tm *time_info = localtime(&timestamp);
+	strftime(buffer, sizeof(char *) * size, "%Y-%m-%d %H:%M:%S", time_info);
+}
+
+double get_monotonic_time() {
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return std::chrono::duration_cast<std::chrono::duration<double> >(now).count();
+}
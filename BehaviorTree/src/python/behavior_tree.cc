@@ -0,0 +1,535 @@
+#include "python/behavior_tree.h"
+#include "python/pyroot.h"
+#include "python/py_leaf.h"
+#include "engine.h"
+#include "column_store.h"
+#include "profile/profiler.h"
+#include "snapshot.h"
+#include "allocation_tracker.h"
+#include <sstream>
+
+static PyObject *AddNode(PyObject *self, PyObject *args, PyObject *keywds);
+static PyObject *IsLazyModeEnable(PyObject *self, PyObject *args);
+static PyObject *EnableLazyMode(PyObject *self, PyObject *args);
+static PyObject *MaterializeTree(PyObject *self, PyObject *args);
+static PyObject *IsProfilerEnable(PyObject *self, PyObject *args);
+static PyObject *EnableProfiler(PyObject *self, PyObject *args);
+static PyObject *ResetProfiler(PyObject *self, PyObject *args);
+static PyObject *DumpProfile(PyObject *self, PyObject *args, PyObject *keywds);
+static PyObject *DumpProfileInPyDictObject();
+static PyObject *DumpProfileInBinaryFormat();
+static PyObject *DumpAllocations(PyObject *self, PyObject *args);
+static PyObject *ResetAllocations(PyObject *self, PyObject *args);
+static PyObject *BatchTick(PyObject *self, PyObject *args, PyObject *keywds);
+static PyObject *SetColumn(PyObject *self, PyObject *args);
+static PyObject *SetValue(PyObject *self, PyObject *args);
+static PyObject *GetValue(PyObject *self, PyObject *args);
+static PyObject *SnapshotRoots(PyObject *self, PyObject *args);
+static PyObject *RestoreRoots(PyObject *self, PyObject *args, PyObject *keywds);
+static bool CheckRoots(PyObject *roots);
+
+static PyObject *AddNode(PyObject *self, PyObject *args, PyObject *keywds) {
+	TRACK_API_CALL("add_node");
+	int id, index, commutative = 0;
+	PyObject *children = NULL, *function = NULL, *params = NULL;
+	static char *kwlist[] = {"id", "index", "children", "function", "params", "commutative", NULL};
+
+	if (!PyArg_ParseTupleAndKeywords(args, keywds, "ii|OOOi", kwlist, &id, &index, &children, &function, &params,
+			&commutative))
+		return NULL;
+
+	if (children && !PyList_Check(children)) {
+		PyErr_SetString(PyExc_TypeError, "The argument children must be a list");
+		return NULL;
+	}
+
+	if (params && !PyList_Check(params)) {
+		PyErr_SetString(PyExc_TypeError, "The argument params must be a list");
+		return NULL;
+	}
+
+	if (function && !PyCallable_Check(function)) {
+		PyErr_SetString(PyExc_TypeError, "The argument function must be callable");
+		return NULL;
+	}
+
+	if (!children && !function && !params) {
+		PyErr_SetString(PyExc_TypeError, "Must pass children, function or params");
+		return NULL;
+	}
+
+	std::vector<int> children_ids;
+	for (Py_ssize_t i = 0; children && i < PyList_Size(children); ++i) {
+		PyObject *item = PyList_GetItem(children, i);
+		int children_id = PyInt_AsLong(item);
+		if (PyErr_Occurred()) {
+			PyErr_SetString(PyExc_RuntimeError, "The element of children must be a integer");
+			return NULL;
+		}
+		children_ids.push_back(children_id);
+	}
+
+	std::vector<double> params_values;
+	for (Py_ssize_t i = 0; params && i < PyList_Size(params); ++i) {
+		PyObject *item = PyList_GetItem(params, i);
+		double value = PyFloat_AsDouble(item);
+		if (PyErr_Occurred()) {
+			PyErr_SetString(PyExc_RuntimeError, "The element of params must be a number");
+			return NULL;
+		}
+		params_values.push_back(value);
+	}
+
+	// in lazy mode, the PyLeaf is only built with the node
+	auto &node_manager = NodeManager::Instance();
+	node_manager.AddFunctionNode(id, index, children_ids, function, params_values, commutative != 0);
+
+	if (!node_manager.HasNode(id)) Py_RETURN_FALSE;
+	else Py_RETURN_TRUE;
+}
+
+static PyObject *IsLazyModeEnable(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("is_lazy_mode_enable");
+	return PyBool_FromLong(NodeManager::Instance().lazy());
+}
+
+static PyObject *EnableLazyMode(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("enable_lazy_mode");
+	int value;
+	if (!PyArg_ParseTuple(args, "i", &value)) return NULL;
+	NodeManager::Instance().SetLazy((value != 0));
+	Py_RETURN_NONE;
+}
+
+static PyObject *MaterializeTree(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("materialize_tree");
+	int id;
+	if (!PyArg_ParseTuple(args, "i", &id)) return NULL;
+	if (!NodeManager::Instance().MaterializeTree(id)) Py_RETURN_FALSE;
+	else Py_RETURN_TRUE;
+}
+
+static PyObject *IsProfilerEnable(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("is_profiler_enable");
+	return PyBool_FromLong(Profiler::Instance().enable());
+}
+
+static PyObject *EnableProfiler(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("enable_profiler");
+#ifndef PROFILE_TICK
+	PySys_WriteStderr("This build doesn't support profile. Recompile the source code with PROFILE_TICK flag to enable profile.\n");
+	Py_RETURN_NONE;
+#endif // !PROFILE_TICK
+
+	int value;
+	if (!PyArg_ParseTuple(args, "i", &value)) return NULL;
+	Profiler::Instance().SetEnable((value != 0));
+	Py_RETURN_NONE;
+}
+
+static PyObject *ResetProfiler(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("reset_profiler");
+	Profiler::Instance().Reset();
+	Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+	DumpProfile__doc__,
+	"DumpProfile(binary=False) -- dump profile data\n\n"
+	"binary: False -- dump profile data in python dictionary\n\n"
+	"binary: True -- dump profile data in binary fomat\n"
+	"format: [total_size][root_id1][collection_size][node_id][profile_data][node_id][profile_data]..."
+	"[root_id2][collection_size][node_id][profile_data][node_id][profile_data]..."
+);
+static PyObject *DumpProfile(PyObject *self, PyObject *args, PyObject *keywds) {
+	TRACK_API_CALL("dump_profile");
+	int binary = 0;
+	static char *kwlist[] = { "binary", NULL };
+	if (!PyArg_ParseTupleAndKeywords(args, keywds, "|i", kwlist, &binary))
+		return NULL;
+	if (!binary) return DumpProfileInPyDictObject();
+	else return DumpProfileInBinaryFormat();
+}
+
+static PyObject *DumpProfileInPyDictObject() {
+	PyObject *py_profile = PyDict_New();
+	auto &collection = *(Profiler::Instance().collections());
+	for (auto &pair : collection) {
+		PyObject *py_root_id = Py_BuildValue("i", pair.first);
+		PyObject *py_collection = PyDict_New();
+		for (auto &inner_pair : pair.second) {
+			PyObject *py_node_id = Py_BuildValue("i", inner_pair.first);
+			PyObject *py_data = PyDict_New();
+
+			PyObject *py_calls = Py_BuildValue("I", inner_pair.second.calls);
+			PyDict_SetItemString(py_data, "calls", py_calls);
+			Py_DECREF(py_calls);
+
+			PyObject *py_clocks = Py_BuildValue("k", inner_pair.second.clocks);
+			PyDict_SetItemString(py_data, "clocks", py_clocks);
+			Py_DECREF(py_clocks);
+
+			PyDict_SetItem(py_collection, py_node_id, py_data);
+			Py_DECREF(py_data);
+			Py_DECREF(py_node_id);
+		}
+		PyDict_SetItem(py_profile, py_root_id, py_collection);
+		Py_DECREF(py_collection);
+		Py_DECREF(py_root_id);
+	}
+	return py_profile;
+}
+
+PyDoc_STRVAR(
+	DumpAllocations__doc__,
+	"dump_allocations() -- dump the heap allocations per API call\n\n"
+	"format: {api: {'calls': calls, 'allocations': allocations, 'bytes': bytes}}"
+);
+static PyObject *DumpAllocations(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("dump_allocations");
+#ifndef TRACK_ALLOCATIONS
+	PySys_WriteStderr("This build doesn't track allocations. Recompile the source code with TRACK_ALLOCATIONS flag to enable it.\n");
+#endif // !TRACK_ALLOCATIONS
+
+	PyObject *py_allocations = PyDict_New();
+	for (auto &pair : *(AllocationTracker::Instance().calls())) {
+		PyObject *py_data = Py_BuildValue("{s:K,s:K,s:K}",
+			"calls", (unsigned PY_LONG_LONG)pair.second.calls,
+			"allocations", (unsigned PY_LONG_LONG)pair.second.stats.allocations,
+			"bytes", (unsigned PY_LONG_LONG)pair.second.stats.bytes);
+		PyDict_SetItemString(py_allocations, pair.first, py_data);
+		Py_DECREF(py_data);
+	}
+	return py_allocations;
+}
+
+static PyObject *ResetAllocations(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("reset_allocations");
+	AllocationTracker::Instance().Reset();
+	Py_RETURN_NONE;
+}
+
+static PyObject *DumpProfileInBinaryFormat() {
+	std::ostringstream out(std::ios::binary | std::ios::out);
+	auto &collections = *(Profiler::Instance().collections());
+	auto total_size = collections.size();
+	out.write(reinterpret_cast<const char *>(&total_size), sizeof(total_size));
+	for (auto &pair : collections) {
+		auto root_id = pair.first;
+		auto &collection = pair.second;
+		auto size = collection.size();
+		out.write(reinterpret_cast<const char *>(&root_id), sizeof(root_id));
+		out.write(reinterpret_cast<char *>(&size), sizeof(size));
+		for (auto &inner_pair : collection) {
+			auto node_id = inner_pair.first;
+			auto profile_data = inner_pair.second;
+			out.write(reinterpret_cast<char *>(&node_id), sizeof(node_id));
+			out.write(reinterpret_cast<char *>(&profile_data), sizeof(profile_data));
+		}
+	}
+	return PyString_FromStringAndSize(out.str().c_str(), out.str().length());
+}
+
+struct BatchBuffers {
+	std::vector<Root *> roots;
+	std::vector<void *> args;
+	std::vector<int> statuses;
+};
+
+PyDoc_STRVAR(
+	BatchTick__doc__,
+	"tick_batch(roots, args=None) -- tick the roots together\n\n"
+	"args: the list of the arguments tuple of each root, empty tuples if None\n\n"
+	"A native condition node evaluates the slots of all the roots at once the first time a root reaches it "
+	"in the batch, so the columns it reads must not be changed by the leaves during the batch.\n\n"
+	"The roots reaching a batch leaf wait until the other roots are ticked, then the leaf is called once "
+	"with the list of their arguments tuples and the roots resume with the returned statuses.\n\n"
+	"A root listed more than once is ticked once."
+);
+static PyObject *BatchTick(PyObject *self, PyObject *args, PyObject *keywds) {
+	TRACK_API_CALL("tick_batch");
+	PyObject *roots = NULL, *args_list = NULL;
+	static char *kwlist[] = { "roots", "args", NULL };
+	if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|O", kwlist, &roots, &args_list))
+		return NULL;
+
+	if (!PyList_Check(roots)) {
+		PyErr_SetString(PyExc_TypeError, "The argument roots must be a list");
+		return NULL;
+	}
+
+	Py_ssize_t size = PyList_Size(roots);
+	if (args_list && args_list != Py_None && (!PyList_Check(args_list) || PyList_Size(args_list) != size)) {
+		PyErr_SetString(PyExc_TypeError, "The argument args must be a list of the same size as roots");
+		return NULL;
+	}
+	if (args_list == Py_None) args_list = NULL;
+
+	for (Py_ssize_t i = 0; i < size; ++i) {
+		if (!PyObject_TypeCheck(PyList_GetItem(roots, i), &RootType)) {
+			PyErr_SetString(PyExc_TypeError, "The element of roots must be a Root");
+			return NULL;
+		}
+		if (args_list && !PyTuple_Check(PyList_GetItem(args_list, i))) {
+			PyErr_SetString(PyExc_TypeError, "The element of args must be a tuple");
+			return NULL;
+		}
+	}
+
+	// the leaves may change the lists, keep the roots and the arguments alive while ticking
+	PyObject *items = PyList_GetSlice(roots, 0, size);
+	PyObject *items_args = args_list ? PyList_GetSlice(args_list, 0, size) : PyTuple_New(0);
+	if (items == NULL || items_args == NULL) {
+		Py_XDECREF(items);
+		Py_XDECREF(items_args);
+		return NULL;
+	}
+
+	// the buffers of the last call are reused, a call nested in a leaf allocates its own
+	static BatchBuffers last_buffers;
+	BatchBuffers buffers;
+	std::swap(buffers, last_buffers);
+	for (Py_ssize_t i = 0; i < size; ++i) {
+		PyRoot *py_root = (PyRoot *)PyList_GET_ITEM(items, i);
+		// an unbound root is kept out of the batch
+		if (!py_root->can_tick) continue;
+		buffers.roots.push_back(py_root->root);
+		buffers.args.push_back(args_list ? PyList_GET_ITEM(items_args, i) : items_args);
+	}
+	buffers.statuses.resize(buffers.roots.size());
+	TickBatch(buffers.roots.data(), buffers.args.data(), buffers.statuses.data(), buffers.roots.size());
+
+	for (Py_ssize_t i = 0, j = 0; i < size; ++i) {
+		PyRoot *py_root = (PyRoot *)PyList_GET_ITEM(items, i);
+		py_root->tick_result = py_root->can_tick ? buffers.statuses[j++] : 0;
+	}
+	buffers.roots.clear();
+	buffers.args.clear();
+	std::swap(buffers, last_buffers);
+
+	Py_DECREF(items);
+	Py_DECREF(items_args);
+	Py_RETURN_NONE;
+}
+
+static PyObject *SetColumn(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("set_column");
+	int column;
+	PyObject *values;
+	if (!PyArg_ParseTuple(args, "iO", &column, &values)) return NULL;
+	if (column < 0) {
+		PyErr_SetString(PyExc_ValueError, "The column must not be negative");
+		return NULL;
+	}
+
+	ColumnStore::Column &data = ColumnStore::Instance().MutableColumn(column);
+	// a buffer of float32, e.g. array.array('f')
+	if (!PyString_Check(values) && PyObject_CheckReadBuffer(values)) {
+		const void *buffer;
+		Py_ssize_t length;
+		if (PyObject_AsReadBuffer(values, &buffer, &length) < 0) return NULL;
+		if (length % sizeof(float) != 0) {
+			PyErr_SetString(PyExc_ValueError, "The buffer size must be a multiple of 4");
+			return NULL;
+		}
+		data.resize(length / sizeof(float));
+		memcpy(data.data(), buffer, length);
+		Py_RETURN_NONE;
+	}
+
+	PyObject *sequence = PySequence_Fast(values, "The argument values must be a sequence or a buffer of float");
+	if (sequence == NULL) return NULL;
+	Py_ssize_t size = PySequence_Fast_GET_SIZE(sequence);
+	ColumnStore::Column column_values(size);
+	for (Py_ssize_t i = 0; i < size; ++i) {
+		column_values[i] = static_cast<float>(PyFloat_AsDouble(PySequence_Fast_GET_ITEM(sequence, i)));
+		if (PyErr_Occurred()) {
+			Py_DECREF(sequence);
+			PyErr_SetString(PyExc_TypeError, "The element of values must be a number");
+			return NULL;
+		}
+	}
+	Py_DECREF(sequence);
+	data.swap(column_values);
+	Py_RETURN_NONE;
+}
+
+static PyObject *SetValue(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("set_value");
+	int column, slot;
+	float value;
+	if (!PyArg_ParseTuple(args, "iif", &column, &slot, &value)) return NULL;
+	if (column < 0 || slot < 0) {
+		PyErr_SetString(PyExc_ValueError, "The column and the slot must not be negative");
+		return NULL;
+	}
+	ColumnStore::Instance().Set(column, slot, value);
+	Py_RETURN_NONE;
+}
+
+static PyObject *GetValue(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("get_value");
+	int column, slot;
+	float value;
+	if (!PyArg_ParseTuple(args, "ii", &column, &slot)) return NULL;
+	if (!ColumnStore::Instance().Get(column, slot, value)) {
+		PyErr_SetString(PyExc_IndexError, "The column or the slot doesn't exist");
+		return NULL;
+	}
+	return PyFloat_FromDouble(value);
+}
+
+static bool CheckRoots(PyObject *roots) {
+	if (!PyList_Check(roots)) {
+		PyErr_SetString(PyExc_TypeError, "The argument roots must be a list");
+		return false;
+	}
+	for (Py_ssize_t i = 0; i < PyList_Size(roots); ++i) {
+		if (!PyObject_TypeCheck(PyList_GetItem(roots, i), &RootType)) {
+			PyErr_SetString(PyExc_TypeError, "The element of roots must be a Root");
+			return false;
+		}
+	}
+	return true;
+}
+
+PyDoc_STRVAR(
+	SnapshotRoots__doc__,
+	"snapshot(roots) -- dump the running state of the roots in binary format\n\n"
+	"The state includes the node id, the slot, the time budget, the resume points and the node data of each root. "
+	"The futures the async leaves are waiting on are not kept, so these leaves start again after restore."
+);
+static PyObject *SnapshotRoots(PyObject *self, PyObject *args) {
+	TRACK_API_CALL("snapshot");
+	PyObject *roots;
+	if (!PyArg_ParseTuple(args, "O", &roots)) return NULL;
+	if (!CheckRoots(roots)) return NULL;
+
+	Py_ssize_t size = PyList_Size(roots);
+	Snapshot snapshot(size);
+	for (Py_ssize_t i = 0; i < size; ++i)
+		snapshot.WriteRoot(*((PyRoot *)PyList_GET_ITEM(roots, i))->root);
+	return PyString_FromStringAndSize(snapshot.data().c_str(), snapshot.data().length());
+}
+
+PyDoc_STRVAR(
+	RestoreRoots__doc__,
+	"restore(data, roots=None) -- restore the running state dumped by snapshot\n\n"
+	"roots: None -- create and return new roots\n\n"
+	"roots: list -- restore into the given roots in order and return them"
+);
+static PyObject *RestoreRoots(PyObject *self, PyObject *args, PyObject *keywds) {
+	TRACK_API_CALL("restore");
+	const char *data;
+	int data_size;
+	PyObject *roots = NULL;
+	static char *kwlist[] = { "data", "roots", NULL };
+	if (!PyArg_ParseTupleAndKeywords(args, keywds, "s#|O", kwlist, &data, &data_size, &roots))
+		return NULL;
+
+	Snapshot snapshot(data, data_size);
+	if (!snapshot.valid()) {
+		PyErr_SetString(PyExc_ValueError, "Invalid snapshot");
+		return NULL;
+	}
+
+	Py_ssize_t size = snapshot.roots_size();
+	if (roots == Py_None) roots = NULL;
+	if (roots) {
+		if (!CheckRoots(roots)) return NULL;
+		if (PyList_Size(roots) != size) {
+			PyErr_SetString(PyExc_ValueError, "The size of roots doesn't match the snapshot");
+			return NULL;
+		}
+		Py_INCREF(roots);
+	}
+	else {
+		roots = PyList_New(size);
+		if (roots == NULL) return NULL;
+		for (Py_ssize_t i = 0; i < size; ++i) {
+			PyObject *root = RootNew(&RootType, NULL, NULL);
+			if (root == NULL) {
+				Py_DECREF(roots);
+				return NULL;
+			}
+			PyList_SET_ITEM(roots, i, root);
+		}
+	}
+
+	for (Py_ssize_t i = 0; i < size; ++i) {
+		PyRoot *py_root = (PyRoot *)PyList_GET_ITEM(roots, i);
+		CancelTickets(*py_root->root);
+		if (!snapshot.ReadRoot(*py_root->root)) {
+			Py_DECREF(roots);
+			PyErr_SetString(PyExc_ValueError, "The snapshot is truncated");
+			return NULL;
+		}
+		BindPyRoot(py_root);
+	}
+	return roots;
+}
+
+static PyMethodDef behavior_tree_methods[] = {
+	{ "add_node", (PyCFunction)AddNode, METH_VARARGS | METH_KEYWORDS, "add_node(id, index, children, function, params, commutative)" },
+	{ "is_lazy_mode_enable", IsLazyModeEnable, METH_VARARGS, "is_lazy_mode_enable()" },
+	{ "enable_lazy_mode", EnableLazyMode, METH_VARARGS, "enable_lazy_mode(value)" },
+	{ "materialize_tree", MaterializeTree, METH_VARARGS, "materialize_tree(id) -- build the node and all its descendants defined in lazy mode" },
+	{ "is_profiler_enable", IsProfilerEnable, METH_VARARGS, "is_profiler_enable()" },
+	{ "enable_profiler", EnableProfiler, METH_VARARGS, "enable_profiler(value)" },
+	{ "reset_profiler", ResetProfiler, METH_VARARGS, "reset_profiler()" },
+	{ "dump_profile", (PyCFunction)DumpProfile, METH_VARARGS | METH_KEYWORDS, DumpProfile__doc__ },
+	{ "dump_allocations", DumpAllocations, METH_NOARGS, DumpAllocations__doc__ },
+	{ "reset_allocations", ResetAllocations, METH_NOARGS, "reset_allocations()" },
+	{ "tick_batch", (PyCFunction)BatchTick, METH_VARARGS | METH_KEYWORDS, BatchTick__doc__ },
+	{ "set_column", SetColumn, METH_VARARGS, "set_column(column, values) -- values: a sequence or a buffer of float" },
+	{ "set_value", SetValue, METH_VARARGS, "set_value(column, slot, value)" },
+	{ "get_value", GetValue, METH_VARARGS, "get_value(column, slot)" },
+	{ "snapshot", SnapshotRoots, METH_VARARGS, SnapshotRoots__doc__ },
+	{ "restore", (PyCFunction)RestoreRoots, METH_VARARGS | METH_KEYWORDS, RestoreRoots__doc__ },
+	{ NULL, NULL, 0, NULL },
+};
+
+// constructed before the node manager, so that it outlives it
+static PyLeafFactory leaf_factory;
+
+void InitModule(const char *module_name) {
+	if (PyType_Ready(&RootType) < 0) return;
+	NodeManager::Instance().SetLeafFactory(&leaf_factory);
+
+	trace_stdout = PySys_WriteStdout;
+	trace_stderr = PySys_WriteStderr;
+
+	PyObject *module = Py_InitModule(module_name, behavior_tree_methods);
+	if (module == NULL) return;
+
+	Py_INCREF(&RootType);
+	PyModule_AddObject(module, "Root", (PyObject *)&RootType);
+
+	PyModule_AddObject(module, "SUCCESS", PyInt_FromLong(SUCCESS));
+	PyModule_AddObject(module, "FAILURE", PyInt_FromLong(FAILURE));
+	PyModule_AddObject(module, "RUNNING", PyInt_FromLong(RUNNING));
+	PyModule_AddObject(module, "YIELDED", PyInt_FromLong(YIELDED));
+	PyModule_AddObject(module, "ERROR", PyInt_FromLong(ERROR));
+
+	// tick functions index
+	PyObject *index = PyDict_New();
+	auto &keys = NodeManager::Instance().function_names();
+	for (size_t i = 0; i < keys.size(); ++i) {
+		PyObject *key = PyString_FromString(keys[i]);
+		PyObject *value = PyInt_FromLong(i);
+		PyDict_SetItem(index, key, value);
+		Py_DECREF(key);
+		Py_DECREF(value);
+	}
+	PyModule_AddObject(module, "FUNCTIONS_INDEX", index);
+
+	// comparison operators of the condition nodes
+	PyObject *comparisons = PyDict_New();
+	const char *operators[] = { "<", "<=", ">", ">=", "==", "!=" };
+	for (int i = 0; i < COMPARE_OP_SIZE; ++i) {
+		PyObject *value = PyInt_FromLong(i);
+		PyDict_SetItemString(comparisons, operators[i], value);
+		Py_DECREF(value);
+	}
+	PyModule_AddObject(module, "COMPARISONS", comparisons);
+}
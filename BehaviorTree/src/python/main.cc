@@ -1,19 +1,19 @@
-#include "global.h"
-#include "behavior_tree.h"
-
-#if defined(_DEBUG) | defined(TRACE_TICK)
-#define MODULE_NAME "behavior_tree_d"
-#else
-#define MODULE_NAME "behavior_tree"
-#endif
-
-PyMODINIT_FUNC
-#if defined(_DEBUG) | defined(TRACE_TICK)
-initbehavior_tree_d() {
-	PyErr_Warn(PyExc_RuntimeWarning, "This is the debug build of behavior_tree module!");
-#else
-initbehavior_tree() {
-#endif
-
-	InitModule(MODULE_NAME);
-}
+#include "python/py_global.h"
+#include "python/behavior_tree.h"
+
+#if defined(_DEBUG) | defined(TRACE_TICK)
+#define MODULE_NAME "behavior_tree_d"
+#else
+#define MODULE_NAME "behavior_tree"
+#endif
+
+PyMODINIT_FUNC
+#if defined(_DEBUG) | defined(TRACE_TICK)
+initbehavior_tree_d() {
+	PyErr_Warn(PyExc_RuntimeWarning, "This is the debug build of behavior_tree module!");
+#else
+initbehavior_tree() {
+#endif
+
+	InitModule(MODULE_NAME);
+}
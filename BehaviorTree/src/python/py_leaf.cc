@@ -0,0 +1,197 @@
+#include "python/py_leaf.h"
+#include <cstdint>
+
+static PyObject *OnFutureDone(PyObject *self, PyObject *future);
+
+static PyMethodDef on_future_done_method = {
+	"on_future_done", (PyCFunction)OnFutureDone, METH_O, "on_future_done(future)"
+};
+
+static PyObject *OnFutureDone(PyObject *self, PyObject *future) {
+	CompletionQueue::Ticket ticket = PyLong_AsUnsignedLong(self);
+	if (PyErr_Occurred()) return NULL;
+
+	int status = ERROR;
+	PyObject *result = PyObject_CallMethod(future, "result", NULL);
+	if (result != NULL) {
+		status = PyInt_AsLong(result);
+		Py_DECREF(result);
+	}
+
+#if defined(_DEBUG) | defined(TRACE_TICK)
+	if (PyErr_Occurred()) PyErr_Print();
+#endif
+
+	PyErr_Clear();
+	if (result == NULL) status = ERROR;
+	CompletionQueue::Instance().Push(ticket, status);
+	Py_RETURN_NONE;
+}
+
+PyLeaf::PyLeaf(PyObject *function) : function_(function), name_("leaf") {
+	Py_XINCREF(function_);
+	PyObject *function_name = PyObject_GetAttrString(function_, "__name__");
+	if (function_name != NULL && PyString_Check(function_name))
+		name_ = PyString_AsString(function_name);
+	Py_XDECREF(function_name);
+	PyErr_Clear();
+}
+
+PyLeaf::~PyLeaf() {
+#ifdef Py_DEBUG
+	// The process terminates and the destruction is called by static variable's destructor(~NodeManager()).
+	// The Python interpreter is finalized at the moment.
+	if (!Py_IsInitialized()) {
+		return;
+	}
+#endif
+
+	Py_XDECREF(function_);
+	function_ = NULL;
+}
+
+PyObject *PyLeaf::Call(void *args) {
+	PyObject *result = PyObject_CallObject(function_, static_cast<PyObject *>(args));
+	if (result == NULL) {
+
+#if defined(_DEBUG) | defined(TRACE_TICK)
+		PyErr_Print();
+#endif
+
+		PyErr_Clear();
+	}
+	return result;
+}
+
+int PyLeaf::Tick(void *args) {
+	PyObject *result = Call(args);
+	if (result == NULL) return ERROR;
+	int status = PyInt_AsLong(result);
+
+#if defined(_DEBUG) | defined(TRACE_TICK)
+	if (PyErr_Occurred()) {
+		char timestamp[64];
+		get_timestamp(timestamp, sizeof(timestamp));
+		PySys_WriteStderr("%s - behavior_tree - %s : %s - ", timestamp, __func__, name_.c_str());
+		PyErr_Print();
+	}
+#endif
+
+	PyErr_Clear();
+	Py_DECREF(result);
+	return status;
+}
+
+int PyLeaf::Start(void *args, CompletionQueue::Ticket &ticket) {
+	ticket = 0;
+	PyObject *result = Call(args);
+	if (result == NULL) return ERROR;
+
+	if (PyInt_Check(result) || PyLong_Check(result)) {
+		int status = PyInt_AsLong(result);
+		Py_DECREF(result);
+		return status;
+	}
+
+	ticket = Watch(result);
+	Py_DECREF(result);
+	if (!ticket) {
+
+#if defined(_DEBUG) | defined(TRACE_TICK)
+		PyErr_Print();
+#endif
+
+		PyErr_Clear();
+		return ERROR;
+	}
+	return RUNNING;
+}
+
+void PyLeaf::TickBatch(void **args, int *statuses, size_t size) {
+	for (size_t i = 0; i < size; ++i) statuses[i] = ERROR;
+	PyObject *contexts = PyList_New(size);
+	if (contexts == NULL) {
+		PyErr_Clear();
+		return;
+	}
+	for (size_t i = 0; i < size; ++i) {
+		PyObject *context = static_cast<PyObject *>(args[i]);
+		Py_INCREF(context);
+		PyList_SET_ITEM(contexts, i, context);
+	}
+
+	PyObject *result = PyObject_CallFunctionObjArgs(function_, contexts, NULL);
+	Py_DECREF(contexts);
+	if (result != NULL && !ReadStatuses(result, statuses, size))
+		for (size_t i = 0; i < size; ++i) statuses[i] = ERROR;
+
+#if defined(_DEBUG) | defined(TRACE_TICK)
+	if (PyErr_Occurred()) {
+		char timestamp[64];
+		get_timestamp(timestamp, sizeof(timestamp));
+		PySys_WriteStderr("%s - behavior_tree - %s : %s - ", timestamp, __func__, name_.c_str());
+		PyErr_Print();
+	}
+#endif
+
+	PyErr_Clear();
+	Py_XDECREF(result);
+}
+
+bool PyLeaf::ReadStatuses(PyObject *result, int *statuses, size_t size) {
+	// a buffer of int32, e.g. array.array('i')
+	if (!PyString_Check(result) && PyObject_CheckReadBuffer(result)) {
+		const void *buffer;
+		Py_ssize_t length;
+		if (PyObject_AsReadBuffer(result, &buffer, &length) < 0) return false;
+		if (static_cast<size_t>(length) != size * sizeof(int32_t)) {
+			PyErr_SetString(PyExc_ValueError, "The buffer must hold an int32 status per root");
+			return false;
+		}
+		for (size_t i = 0; i < size; ++i) statuses[i] = static_cast<const int32_t *>(buffer)[i];
+		return true;
+	}
+
+	PyObject *sequence = PySequence_Fast(result, "The batch leaf must return a sequence or a buffer of statuses");
+	if (sequence == NULL) return false;
+	if (static_cast<size_t>(PySequence_Fast_GET_SIZE(sequence)) != size) {
+		Py_DECREF(sequence);
+		PyErr_SetString(PyExc_ValueError, "The batch leaf must return a status per root");
+		return false;
+	}
+	for (size_t i = 0; i < size; ++i) {
+		statuses[i] = PyInt_AsLong(PySequence_Fast_GET_ITEM(sequence, i));
+		if (PyErr_Occurred()) {
+			Py_DECREF(sequence);
+			return false;
+		}
+	}
+	Py_DECREF(sequence);
+	return true;
+}
+
+CompletionQueue::Ticket PyLeaf::Watch(PyObject *future) {
+	CompletionQueue &queue = CompletionQueue::Instance();
+	CompletionQueue::Ticket ticket = queue.Start();
+	PyObject *py_ticket = PyLong_FromUnsignedLong(ticket);
+	if (py_ticket == NULL) {
+		queue.Cancel(ticket);
+		return 0;
+	}
+	PyObject *callback = PyCFunction_New(&on_future_done_method, py_ticket);
+	Py_DECREF(py_ticket);
+	if (callback == NULL) {
+		queue.Cancel(ticket);
+		return 0;
+	}
+
+	// the callback may run synchronously if the future is already done
+	PyObject *result = PyObject_CallMethod(future, "add_done_callback", "O", callback);
+	Py_DECREF(callback);
+	if (result == NULL) {
+		queue.Cancel(ticket);
+		return 0;
+	}
+	Py_DECREF(result);
+	return ticket;
+}
@@ -0,0 +1,16 @@
+# -*- coding: utf-8 -*-
+# Imports the module built by cmake, whose directory is passed as the first argument by ctest.
+
+import sys
+import unittest
+
+if len(sys.argv) > 1:
+    sys.path.insert(0, sys.argv.pop(1))
+
+import behavior_tree
+
+F = behavior_tree.FUNCTIONS_INDEX
+
+
+def main():
+    unittest.main()
@@ -0,0 +1,125 @@
+# -*- coding: utf-8 -*-
+# Steady-state ticking must not allocate. Only registered when the module is built with TRACK_ALLOCATIONS.
+
+from common import behavior_tree, F, main
+import unittest
+
+
+def success(*args):
+    return behavior_tree.SUCCESS
+
+
+def failure(*args):
+    return behavior_tree.FAILURE
+
+
+def query(*args):
+    # an API call nested in a tick, its name is longer than a short string
+    behavior_tree.is_lazy_mode_enable()
+    return behavior_tree.SUCCESS
+
+
+def batch_success(contexts):
+    return [behavior_tree.SUCCESS] * len(contexts)
+
+
+class AllocationTest(unittest.TestCase):
+    ROOTS = 8
+    WARM_UP = 3
+    TICKS = 3000
+
+    @classmethod
+    def setUpClass(cls):
+        add = behavior_tree.add_node
+        add(1000, F['tick_leaf'], function=success)
+        add(1001, F['tick_leaf'], function=failure)
+        add(1002, F['tick_batch_leaf'], function=batch_success)
+        add(1003, F['tick_leaf'], function=query)
+        # composites
+        add(1010, F['mem_run_until_fail'], children=[1000, 1000, 1001])
+        add(1011, F['mem_run_until_success'], children=[1001, 1000])
+        add(1012, F['run_until_fail'], children=[1000, 1011])
+        add(1013, F['tick_node'], children=[1010])
+        # decorators
+        add(1020, F['repeat'], children=[1000], params=[3])
+        add(1021, F['retry'], children=[1001], params=[2])
+        add(1022, F['timeout'], children=[1020], params=[3600])
+        add(1023, F['cooldown'], children=[1000], params=[0])
+        add(1024, F['rate_limit'], children=[1000], params=[1000000, 1])
+        add(1025, F['report_success'], children=[1021])
+        add(1026, F['report_failure'], children=[1023])
+        add(1027, F['revert_status'], children=[1026])
+        # condition nodes
+        lt = behavior_tree.COMPARISONS['<']
+        add(1030, F['compare_value'], params=[lt, 0, 5.0])
+        add(1031, F['compare_columns'], params=[lt, 0, 1])
+        # commutative composites, reordered every 1024 traversals
+        add(1040, F['run_until_success'], children=[1001, 1030, 1000], commutative=1)
+        add(1041, F['run_until_fail'], children=[1000, 1031, 1001], commutative=1)
+
+        add(1050, F['run_until_fail'], children=[
+            1013, 1012, 1022, 1024, 1025, 1027, 1040, 1041, 1002, 1000])
+        add(1051, F['run_until_success'], children=[1050, 1000])
+
+        behavior_tree.set_column(0, [float(i) for i in range(cls.ROOTS)])
+        behavior_tree.set_column(1, [3.0] * cls.ROOTS)
+
+    def make_roots(self):
+        roots = [behavior_tree.Root(1051) for _ in range(self.ROOTS)]
+        for slot, root in enumerate(roots):
+            root.slot = slot
+        return roots
+
+    def test_tracking(self):
+        root = behavior_tree.Root(1051)
+        self.assertTrue(root.can_tick)
+        root.tick()
+        # the first tick creates the data of the nodes
+        self.assertGreater(root.tick_allocations[0], 0)
+
+    def test_tick(self):
+        roots = self.make_roots()
+        for _ in range(self.WARM_UP):
+            for root in roots:
+                root.tick()
+        for _ in range(self.TICKS):
+            for root in roots:
+                root.tick()
+                self.assertEqual(root.tick_allocations, (0, 0))
+
+    def test_tick_batch(self):
+        roots = self.make_roots()
+        args = [(slot,) for slot in range(self.ROOTS)]
+        for _ in range(self.WARM_UP):
+            behavior_tree.tick_batch(roots, args)
+        behavior_tree.reset_allocations()
+        for _ in range(self.TICKS):
+            behavior_tree.tick_batch(roots, args)
+            for root in roots:
+                self.assertEqual(root.tick_allocations, (0, 0))
+        calls = behavior_tree.dump_allocations()['tick_batch']
+        self.assertEqual(calls['calls'], self.TICKS)
+        self.assertEqual(calls['allocations'], 0)
+
+    def test_api_calls(self):
+        behavior_tree.reset_allocations()
+        root = behavior_tree.Root(1003)
+        root.tick()
+        root.stop_replay()
+        behavior_tree.get_value(0, 0)
+        behavior_tree.enable_lazy_mode(0)
+        behavior_tree.is_profiler_enable()
+        behavior_tree.reset_profiler()
+        calls = behavior_tree.dump_allocations()
+        for api in ['Root.__new__', 'Root.__init__', 'Root.tick', 'Root.stop_replay', 'is_lazy_mode_enable',
+                    'get_value', 'enable_lazy_mode', 'is_profiler_enable', 'reset_profiler']:
+            self.assertEqual(calls[api]['calls'], 1, api)
+
+        # recording the nested call doesn't allocate
+        for _ in range(self.TICKS):
+            root.tick()
+            self.assertEqual(root.tick_allocations, (0, 0))
+
+
+if __name__ == '__main__':
+    main()
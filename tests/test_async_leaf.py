@@ -0,0 +1,83 @@
+# -*- coding: utf-8 -*-
+
+from common import behavior_tree, F, main
+import unittest
+
+
+class Future(object):
+    def __init__(self):
+        self.status = None
+        self.callbacks = []
+
+    def add_done_callback(self, callback):
+        if self.status is not None:
+            callback(self)
+        else:
+            self.callbacks.append(callback)
+
+    def result(self):
+        return self.status
+
+    def set_result(self, status):
+        self.status = status
+        for callback in self.callbacks:
+            callback(self)
+
+
+guard = [behavior_tree.FAILURE]
+futures = []
+
+
+def check_guard(*args):
+    return guard[0]
+
+
+def start(*args):
+    futures.append(Future())
+    return futures[-1]
+
+
+class AsyncLeafTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        add = behavior_tree.add_node
+        add(4000, F['tick_leaf'], function=check_guard)
+        add(4001, F['tick_async_leaf'], function=start)
+        add(4002, F['run_until_success'], children=[4000, 4001])
+
+    def setUp(self):
+        guard[0] = behavior_tree.FAILURE
+        del futures[:]
+
+    def test_future(self):
+        root = behavior_tree.Root(4002)
+        root.tick()
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.RUNNING)
+        futures[0].set_result(behavior_tree.SUCCESS)
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.SUCCESS)
+        self.assertEqual(len(futures), 1)
+
+    def test_dropped_future(self):
+        root = behavior_tree.Root(4002)
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.RUNNING)
+
+        # the selector stops waiting on the leaf
+        guard[0] = behavior_tree.SUCCESS
+        root.tick()
+        futures[0].set_result(behavior_tree.FAILURE)
+        guard[0] = behavior_tree.FAILURE
+
+        # the leaf starts a new work instead of reporting the dropped one
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.RUNNING)
+        self.assertEqual(len(futures), 2)
+        futures[1].set_result(behavior_tree.SUCCESS)
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.SUCCESS)
+
+
+if __name__ == '__main__':
+    main()
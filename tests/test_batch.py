@@ -0,0 +1,133 @@
+# -*- coding: utf-8 -*-
+
+from common import behavior_tree, F, main
+import time
+import unittest
+
+
+def success(*args):
+    return behavior_tree.SUCCESS
+
+
+def slow(*args):
+    start = time.time()
+    while time.time() - start < 0.002:
+        pass
+    return behavior_tree.SUCCESS
+
+
+calls = []
+
+
+def batch_success(contexts):
+    calls.append(len(contexts))
+    return [behavior_tree.SUCCESS] * len(contexts)
+
+
+def slow_batch_success(contexts):
+    calls.append(len(contexts))
+    time.sleep(0.01)
+    return [behavior_tree.SUCCESS] * len(contexts)
+
+
+counter = [0]
+
+
+def count(*args):
+    counter[0] += 1
+    return behavior_tree.SUCCESS
+
+
+def slow_failure(*args):
+    start = time.time()
+    while time.time() - start < 0.00005:
+        pass
+    return behavior_tree.FAILURE
+
+
+nested_roots = []
+
+
+def tick_nested(*args):
+    behavior_tree.tick_batch(nested_roots)
+    return behavior_tree.SUCCESS
+
+
+class BatchLeafTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        add = behavior_tree.add_node
+        add(3000, F['tick_leaf'], function=success)
+        add(3001, F['tick_leaf'], function=slow)
+        add(3002, F['tick_batch_leaf'], function=batch_success)
+        add(3003, F['tick_leaf'], function=tick_nested)
+        add(3010, F['tick_node'], children=[3002])
+        add(3011, F['tick_node'], children=[3003])
+        add(3012, F['run_until_fail'], children=[3002, 3001, 3002, 3001, 3002, 3001])
+        add(3004, F['tick_leaf'], function=count)
+        add(3005, F['tick_batch_leaf'], function=slow_batch_success)
+        add(3013, F['run_until_fail'], children=[3004, 3005])
+        add(3014, F['timeout'], children=[3013], params=[0.001])
+        add(3015, F['run_until_success'], children=[3014, 3013])
+        # the batch leaf succeeds quicker than the first child, so the children are swapped
+        add(3006, F['tick_leaf'], function=slow_failure)
+        add(3016, F['run_until_success'], children=[3006, 3002], commutative=1)
+
+    def setUp(self):
+        del calls[:]
+        counter[0] = 0
+
+    def test_batch_leaf(self):
+        roots = [behavior_tree.Root(3010) for _ in range(4)]
+        behavior_tree.tick_batch(roots, [(i,) for i in range(4)])
+        self.assertEqual(calls, [4])
+        self.assertEqual([root.tick_result for root in roots], [behavior_tree.SUCCESS] * 4)
+
+    def test_duplicated_root(self):
+        roots = [behavior_tree.Root(3010) for _ in range(2)]
+        behavior_tree.tick_batch(roots + roots)
+        self.assertEqual(calls, [2])
+        self.assertEqual([root.tick_result for root in roots], [behavior_tree.SUCCESS] * 2)
+
+    def test_nested_tick_batch(self):
+        nested_roots[:] = [behavior_tree.Root(3010) for _ in range(2)]
+        roots = [behavior_tree.Root(3010), behavior_tree.Root(3011), behavior_tree.Root(3010)]
+        behavior_tree.tick_batch(roots)
+        self.assertEqual(sorted(calls), [2, 2])
+        self.assertEqual([root.tick_result for root in roots], [behavior_tree.SUCCESS] * 3)
+        self.assertEqual([root.tick_result for root in nested_roots], [behavior_tree.SUCCESS] * 2)
+
+    def test_left_path(self):
+        # the timeout fails the resumed tick before it reaches the batch leaf again,
+        # so node 3013 is then ticked from its first child instead of resuming at the batch leaf
+        root = behavior_tree.Root(3015)
+        behavior_tree.tick_batch([root])
+        self.assertEqual(root.tick_result, behavior_tree.SUCCESS)
+        self.assertEqual(counter[0], 2)
+        self.assertEqual(calls, [1, 1])
+
+    def test_commutative_node(self):
+        # the node isn't reordered while other roots of the batch wait in it, so they tick the leaf once
+        roots = [behavior_tree.Root(3016) for _ in range(5)]
+        for _ in range(300):
+            del calls[:]
+            behavior_tree.tick_batch(roots)
+            self.assertEqual(sum(calls), len(roots))
+            self.assertEqual([root.tick_result for root in roots], [behavior_tree.SUCCESS] * len(roots))
+
+    def test_time_budget(self):
+        # the resumed ticks continue with the budget left, instead of a new budget per batch leaf,
+        # so the two slow leaves after the batch leaves exceed it
+        root = behavior_tree.Root(3012)
+        root.time_budget = 0.003
+        behavior_tree.tick_batch([root])
+        self.assertEqual(root.tick_result, behavior_tree.YIELDED)
+        for _ in range(10):
+            if root.tick_result != behavior_tree.YIELDED:
+                break
+            behavior_tree.tick_batch([root])
+        self.assertEqual(root.tick_result, behavior_tree.SUCCESS)
+
+
+if __name__ == '__main__':
+    main()
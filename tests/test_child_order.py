@@ -0,0 +1,71 @@
+# -*- coding: utf-8 -*-
+
+from common import behavior_tree, F, main
+import time
+import unittest
+
+PERIOD = 1024
+
+calls = []
+
+
+def slow_failure(*args):
+    calls.append('slow')
+    start = time.time()
+    while time.time() - start < 0.0002:
+        pass
+    return behavior_tree.FAILURE
+
+
+def success(*args):
+    calls.append('success')
+    return behavior_tree.SUCCESS
+
+
+class ChildOrderTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        add = behavior_tree.add_node
+        add(9000, F['tick_leaf'], function=slow_failure)
+        add(9001, F['tick_leaf'], function=success)
+        # the second child is cheaper and ends the traversal, so it ranks first
+        add(9010, F['run_until_success'], children=[9000, 9001], commutative=1)
+        add(9011, F['run_until_success'], children=[9000, 9001], commutative=1)
+
+    def setUp(self):
+        del calls[:]
+
+    def test_reorder(self):
+        root = behavior_tree.Root(9010)
+        for _ in range(PERIOD - 1):
+            root.tick()
+        self.assertEqual(calls.count('slow'), PERIOD - 1)
+        del calls[:]
+        for _ in range(10):
+            root.tick()
+            self.assertEqual(root.tick_result, behavior_tree.SUCCESS)
+        self.assertEqual(calls, ['success'] * 10)
+
+    def test_suspended_root(self):
+        # suspended before the second child, which becomes the first one
+        suspended = behavior_tree.Root(9011)
+        suspended.time_budget = 0.0001
+        suspended.tick()
+        self.assertTrue(suspended.yielded)
+
+        root = behavior_tree.Root(9011)
+        for _ in range(PERIOD):
+            root.tick()
+        del calls[:]
+        root.tick()
+        self.assertEqual(calls, ['success'])
+
+        # the reordered node restarts instead of resuming at the index of the old order
+        del calls[:]
+        suspended.tick()
+        self.assertEqual(suspended.tick_result, behavior_tree.SUCCESS)
+        self.assertEqual(calls, ['success'])
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,44 @@
+# -*- coding: utf-8 -*-
+
+from common import behavior_tree, F, main
+import random
+import unittest
+
+
+class ConditionTest(unittest.TestCase):
+    SIZES = [1, 7, 15, 16, 17, 33, 50]
+    MIN_SLOT = 5
+
+    @classmethod
+    def setUpClass(cls):
+        cls.nodes = []
+        for op in sorted(behavior_tree.COMPARISONS.values()):
+            value_id, columns_id = 8000 + op * 2, 8001 + op * 2
+            behavior_tree.add_node(value_id, F['compare_value'], params=[op, 0, 3.0])
+            behavior_tree.add_node(columns_id, F['compare_columns'], params=[op, 0, 1])
+            cls.nodes += [value_id, columns_id]
+
+        # small integers, so that the operands are often equal
+        random.seed(0)
+        slots = cls.MIN_SLOT + max(cls.SIZES)
+        behavior_tree.set_column(0, [float(random.randint(0, 6)) for _ in range(slots)])
+        behavior_tree.set_column(1, [float(random.randint(0, 6)) for _ in range(slots)])
+
+    def test_batch(self):
+        # the batch is evaluated at once, the single roots by the scalar comparison
+        for node_id in self.nodes:
+            for size in self.SIZES:
+                roots = [behavior_tree.Root(node_id) for _ in range(size)]
+                for i, root in enumerate(roots):
+                    root.slot = self.MIN_SLOT + i
+                behavior_tree.tick_batch(roots)
+                batch = [root.tick_result for root in roots]
+                for root in roots:
+                    root.tick()
+                single = [root.tick_result for root in roots]
+                self.assertEqual(batch, single, (node_id, size))
+                self.assertTrue(set(single) <= set([behavior_tree.SUCCESS, behavior_tree.FAILURE]))
+
+
+if __name__ == '__main__':
+    main()
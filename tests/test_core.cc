@@ -0,0 +1,78 @@
+// Ticks trees of native leaves through the C++ API, without the Python interpreter.
+
+#include "engine.h"
+#include "column_store.h"
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK_EQUAL(expected, actual) \
+	do { \
+		int expected_value = (expected), actual_value = (actual); \
+		if (expected_value != actual_value) { \
+			fprintf(stderr, "%s:%d: %s is %d, expected %d\n", __FILE__, __LINE__, #actual, actual_value, \
+				expected_value); \
+			++failures; \
+		} \
+	} while (0)
+
+// ticked once per batch tick with the arguments of all the roots reaching it
+class BatchLeaf : public Leaf {
+public:
+	BatchLeaf() : calls(0) {}
+	int Tick(void *args) override { return *static_cast<int *>(args); }
+	void TickBatch(void **args, int *statuses, size_t size) override {
+		++calls;
+		Leaf::TickBatch(args, statuses, size);
+	}
+
+	int calls;
+};
+
+int main() {
+	NodeManager &manager = NodeManager::Instance();
+	int ticks = 0;
+	auto count = std::make_shared<NativeLeaf>("count", [&ticks](void *args) { ++ticks; return SUCCESS; });
+	auto batch_leaf = std::make_shared<BatchLeaf>();
+	manager.AddNode(1, manager.FindFunction("tick_leaf"), {}, count, {});
+	manager.AddNode(2, manager.FindFunction("tick_batch_leaf"), {}, batch_leaf, {});
+	manager.AddNode(3, manager.FindFunction("compare_value"), {}, nullptr, {LESS, 0, 2.0});
+	manager.AddNode(4, manager.FindFunction("run_until_fail"), {1, 3, 2}, nullptr, {});
+	manager.AddNode(5, manager.FindFunction("tick_node"), {4}, nullptr, {});
+
+	Root unbound;
+	CHECK_EQUAL(0, BindRoot(unbound, 100));
+	CHECK_EQUAL(0, TickRoot(unbound, NULL));
+
+	// the slots 0 and 1 pass the condition, the slot 2 doesn't
+	for (int slot = 0; slot < 3; ++slot) ColumnStore::Instance().Set(0, slot, static_cast<float>(slot));
+	const size_t size = 3;
+	Root roots[size];
+	int args[size] = { SUCCESS, FAILURE, SUCCESS };
+	for (size_t i = 0; i < size; ++i) {
+		CHECK_EQUAL(1, BindRoot(roots[i], 5));
+		roots[i].slot = static_cast<int>(i);
+	}
+
+	CHECK_EQUAL(SUCCESS, TickRoot(roots[0], &args[0]));
+	CHECK_EQUAL(FAILURE, TickRoot(roots[1], &args[1]));
+	CHECK_EQUAL(FAILURE, TickRoot(roots[2], &args[2]));
+	CHECK_EQUAL(3, ticks);
+	CHECK_EQUAL(2, batch_leaf->calls);
+
+	Root *batch_roots[size] = { &roots[0], &roots[1], &roots[2] };
+	void *batch_args[size] = { &args[0], &args[1], &args[2] };
+	int statuses[size];
+	batch_leaf->calls = 0;
+	TickBatch(batch_roots, batch_args, statuses, size);
+	CHECK_EQUAL(SUCCESS, statuses[0]);
+	CHECK_EQUAL(FAILURE, statuses[1]);
+	CHECK_EQUAL(FAILURE, statuses[2]);
+	CHECK_EQUAL(1, batch_leaf->calls);
+
+	for (size_t i = 0; i < size; ++i) CancelTickets(roots[i]);
+	if (failures == 0) printf("OK\n");
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+# -*- coding: utf-8 -*-
+
+from common import behavior_tree, F, main
+import time
+import unittest
+
+
+def running(*args):
+    return behavior_tree.RUNNING
+
+
+def slow(*args):
+    start = time.time()
+    while time.time() - start < 0.002:
+        pass
+    return behavior_tree.SUCCESS
+
+
+def batch_success(contexts):
+    return [behavior_tree.SUCCESS] * len(contexts)
+
+
+class Future(object):
+    def add_done_callback(self, callback):
+        pass
+
+
+futures = []
+
+
+def start(*args):
+    futures.append(Future())
+    return futures[-1]
+
+
+counter = [0]
+
+
+def count(*args):
+    counter[0] += 1
+    return behavior_tree.SUCCESS
+
+
+class TimeoutTest(unittest.TestCase):
+    TIMEOUT = 0.05
+
+    @classmethod
+    def setUpClass(cls):
+        add = behavior_tree.add_node
+        add(2000, F['tick_leaf'], function=running)
+        add(2001, F['tick_leaf'], function=slow)
+        add(2002, F['tick_batch_leaf'], function=batch_success)
+        add(2003, F['timeout'], children=[2000], params=[cls.TIMEOUT])
+        # the ticks yield after the timeout node
+        add(2010, F['run_until_fail'], children=[2003, 2001, 2001])
+        add(2011, F['run_until_fail'], children=[2003, 2002])
+        # the child is aborted by the timeout
+        add(2004, F['tick_async_leaf'], function=start)
+        add(2005, F['tick_leaf'], function=count)
+        add(2006, F['mem_run_until_fail'], children=[2005, 2000])
+        add(2012, F['timeout'], children=[2004], params=[cls.TIMEOUT])
+        add(2013, F['retry'], children=[2012], params=[3])
+        add(2014, F['timeout'], children=[2006], params=[cls.TIMEOUT])
+
+    def setUp(self):
+        del futures[:]
+        counter[0] = 0
+
+    def tick_until_failure(self, tick, root):
+        end = time.time() + self.TIMEOUT * 10
+        while time.time() < end:
+            tick()
+            if root.tick_result == behavior_tree.FAILURE:
+                return True
+        return False
+
+    def test_timeout(self):
+        root = behavior_tree.Root(2010)
+        self.assertTrue(self.tick_until_failure(root.tick, root))
+
+    def test_timeout_with_time_budget(self):
+        root = behavior_tree.Root(2010)
+        root.time_budget = 0.001
+        self.assertTrue(self.tick_until_failure(root.tick, root))
+
+    def test_timeout_with_batch_leaf(self):
+        root = behavior_tree.Root(2011)
+        self.assertTrue(self.tick_until_failure(lambda: behavior_tree.tick_batch([root]), root))
+
+    def test_retry_async_leaf(self):
+        root = behavior_tree.Root(2013)
+        for _ in range(4):
+            root.tick()
+            time.sleep(self.TIMEOUT)
+        # every attempt starts a new work
+        self.assertEqual(root.tick_result, behavior_tree.FAILURE)
+        self.assertEqual(len(futures), 3)
+
+    def test_restart_mem_composite(self):
+        root = behavior_tree.Root(2014)
+        root.tick()
+        time.sleep(self.TIMEOUT)
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.FAILURE)
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.RUNNING)
+        self.assertEqual(counter[0], 2)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,70 @@
+# -*- coding: utf-8 -*-
+
+from common import behavior_tree, F, main
+import sys
+import unittest
+
+
+def succeed(*args):
+    return behavior_tree.SUCCESS
+
+
+class LazyModeTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        behavior_tree.enable_lazy_mode(1)
+        add = behavior_tree.add_node
+        add(5000, F['tick_leaf'], function=succeed)
+        add(5001, F['revert_status'], children=[5000])
+        add(5002, F['run_until_success'], children=[5001, 5000])
+        add(5003, F['run_until_fail'], children=[5002, 5000])
+
+    @classmethod
+    def tearDownClass(cls):
+        behavior_tree.enable_lazy_mode(0)
+
+    def test_materialize_tree(self):
+        self.assertTrue(behavior_tree.materialize_tree(5003))
+        self.assertFalse(behavior_tree.materialize_tree(5999))
+
+        # no node is built by the tick
+        root = behavior_tree.Root(5003)
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.SUCCESS)
+        self.assertEqual(root.tick_allocations, (0, 0))
+
+    def test_leaf_references(self):
+        def leaf(*args):
+            return behavior_tree.SUCCESS
+
+        references = sys.getrefcount(leaf)
+        for node_id in range(7000, 8000):
+            behavior_tree.add_node(node_id, F['tick_leaf'], function=leaf)
+        # the definitions share a reference to the function
+        self.assertEqual(sys.getrefcount(leaf), references + 1)
+
+        behavior_tree.add_node(8000, F['tick_node'], children=[7000])
+        self.assertTrue(behavior_tree.materialize_tree(8000))
+        root = behavior_tree.Root(8000)
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.SUCCESS)
+
+    def test_redefinition(self):
+        def leaf(*args):
+            return behavior_tree.SUCCESS
+
+        def other_leaf(*args):
+            return behavior_tree.FAILURE
+
+        references = sys.getrefcount(leaf)
+        behavior_tree.add_node(6200, F['tick_leaf'], function=leaf)
+        behavior_tree.add_node(6200, F['tick_leaf'], function=other_leaf)
+        # the superseded definition releases the function
+        self.assertEqual(sys.getrefcount(leaf), references)
+        root = behavior_tree.Root(6200)
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.FAILURE)
+
+
+if __name__ == '__main__':
+    main()
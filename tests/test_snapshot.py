@@ -0,0 +1,142 @@
+# -*- coding: utf-8 -*-
+
+from common import behavior_tree, F, main
+import time
+import unittest
+
+
+class Future(object):
+    def __init__(self):
+        self.callbacks = []
+
+    def add_done_callback(self, callback):
+        self.callbacks.append(callback)
+
+    def result(self):
+        return behavior_tree.SUCCESS
+
+    def set_done(self):
+        for callback in self.callbacks:
+            callback(self)
+
+
+calls = []
+futures = []
+
+
+def success(*args):
+    calls.append('success')
+    return behavior_tree.SUCCESS
+
+
+def running(*args):
+    calls.append('running')
+    return behavior_tree.RUNNING
+
+
+def start(*args):
+    futures.append(Future())
+    return futures[-1]
+
+
+class SnapshotTest(unittest.TestCase):
+    COOLDOWN = 0.3
+
+    @classmethod
+    def setUpClass(cls):
+        add = behavior_tree.add_node
+        add(7000, F['tick_leaf'], function=success)
+        add(7001, F['tick_leaf'], function=running)
+        add(7002, F['tick_async_leaf'], function=start)
+        add(7010, F['mem_run_until_fail'], children=[7000, 7001])
+        add(7011, F['rate_limit'], children=[7000], params=[2, 3600])
+        add(7012, F['cooldown'], children=[7000], params=[cls.COOLDOWN])
+
+    def setUp(self):
+        del calls[:]
+        del futures[:]
+
+    def round_trip(self, root):
+        roots = behavior_tree.restore(behavior_tree.snapshot([root]))
+        self.assertEqual(len(roots), 1)
+        self.assertIsNot(roots[0], root)
+        self.assertEqual(roots[0].node_id, root.node_id)
+        return roots[0]
+
+    def test_mem_composite(self):
+        root = behavior_tree.Root(7010)
+        root.tick()
+        del calls[:]
+        # the restored node resumes at its running child
+        restored = self.round_trip(root)
+        restored.tick()
+        self.assertEqual(restored.tick_result, behavior_tree.RUNNING)
+        self.assertEqual(calls, ['running'])
+
+    def test_decorator_counter(self):
+        root = behavior_tree.Root(7011)
+        root.tick()
+        root.tick()
+        restored = self.round_trip(root)
+        restored.tick()
+        self.assertEqual(restored.tick_result, behavior_tree.FAILURE)
+
+    def test_cooldown_rebase(self):
+        root = behavior_tree.Root(7012)
+        root.tick()
+        data = behavior_tree.snapshot([root])
+        time.sleep(self.COOLDOWN / 2)
+        # the cooldown left at the snapshot starts again at the restore
+        restored = behavior_tree.restore(data)[0]
+        time.sleep(self.COOLDOWN * 2 / 3)
+        restored.tick()
+        self.assertEqual(restored.tick_result, behavior_tree.FAILURE)
+        time.sleep(self.COOLDOWN / 2)
+        restored.tick()
+        self.assertEqual(restored.tick_result, behavior_tree.SUCCESS)
+
+    def test_restore_in_place(self):
+        root = behavior_tree.Root(7010)
+        root.tick()
+        data = behavior_tree.snapshot([root])
+        other = behavior_tree.Root(7011)
+        roots = behavior_tree.restore(data, [other])
+        self.assertIs(roots[0], other)
+        self.assertEqual(other.node_id, 7010)
+        self.assertTrue(other.can_tick)
+        del calls[:]
+        other.tick()
+        self.assertEqual(calls, ['running'])
+
+    def test_invalid_data(self):
+        root = behavior_tree.Root(7010)
+        root.tick()
+        data = behavior_tree.snapshot([root])
+        self.assertRaises(ValueError, behavior_tree.restore, data[:-1])
+        self.assertRaises(ValueError, behavior_tree.restore, 'XXXX' + data[4:])
+        self.assertRaises(ValueError, behavior_tree.restore, data[:3])
+        self.assertRaises(ValueError, behavior_tree.restore, data, [root, root])
+        self.assertRaises(TypeError, behavior_tree.restore, data, [None])
+
+    def test_dropped_ticket(self):
+        root = behavior_tree.Root(7002)
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.RUNNING)
+        data = behavior_tree.snapshot([root])
+
+        # the restored roots start the work again
+        restored = behavior_tree.restore(data)[0]
+        restored.tick()
+        self.assertEqual(restored.tick_result, behavior_tree.RUNNING)
+        self.assertEqual(len(futures), 2)
+
+        # restoring in place drops the work the root waited on
+        behavior_tree.restore(data, [root])
+        futures[0].set_done()
+        root.tick()
+        self.assertEqual(root.tick_result, behavior_tree.RUNNING)
+        self.assertEqual(len(futures), 3)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,195 @@
+# -*- coding: utf-8 -*-
+
+from common import behavior_tree, F, main
+import time
+import unittest
+
+
+calls = []
+
+
+def success(*args):
+    calls.append('success')
+    return behavior_tree.SUCCESS
+
+
+def failure(*args):
+    return behavior_tree.FAILURE
+
+
+def slow(*args):
+    start = time.time()
+    while time.time() - start < 0.002:
+        pass
+    return behavior_tree.SUCCESS
+
+
+class TickLogTest(unittest.TestCase):
+    TICKS = 5
+
+    @classmethod
+    def setUpClass(cls):
+        add = behavior_tree.add_node
+        add(6000, F['tick_leaf'], function=success)
+        add(6001, F['tick_leaf'], function=failure)
+        add(6010, F['cooldown'], children=[6000], params=[0.05])
+        add(6011, F['run_until_success'], children=[6010, 6001])
+        lt = behavior_tree.COMPARISONS['<']
+        add(6020, F['compare_value'], params=[lt, 0, 5.0])
+        add(6021, F['compare_columns'], params=[lt, 0, 1])
+        add(6022, F['run_until_fail'], children=[6020, 6021, 6000])
+        add(6002, F['tick_leaf'], function=slow)
+        add(6030, F['run_until_fail'], children=[6002, 6002, 6002])
+        add(6040, F['tick_node'], children=[6011])
+        add(6050, F['run_until_fail'], children=[6000, 6001])
+
+    def record(self, node_id, interval=0, **kwargs):
+        root = behavior_tree.Root(node_id)
+        root.start_recording(**kwargs)
+        results = []
+        for _ in range(self.TICKS):
+            root.tick()
+            results.append(root.tick_result)
+            time.sleep(interval)
+        return root.stop_recording(), results
+
+    def replay(self, node_id, log):
+        root = behavior_tree.Root(node_id)
+        root.start_replay(log)
+        results = []
+        for _ in range(self.TICKS):
+            root.tick()
+            results.append(root.tick_result)
+        return root, results
+
+    def setUp(self):
+        del calls[:]
+
+    def test_round_trip(self):
+        log, results = self.record(6050)
+        latency_log, latency_results = self.record(6050, latency=True)
+        self.assertEqual(latency_results, results)
+        self.assertGreater(len(latency_log), len(log))
+
+        for data in [log, latency_log]:
+            del calls[:]
+            root, replayed = self.replay(6050, data)
+            # the leaves are not called
+            self.assertEqual(calls, [])
+            self.assertEqual(replayed, results)
+            self.assertTrue(root.replaying)
+            # the log is exhausted
+            root.tick()
+            self.assertFalse(root.replaying)
+            self.assertEqual(root.tick_result, 0)
+            root.stop_replay()
+            root.tick()
+            self.assertEqual(root.tick_result, behavior_tree.FAILURE)
+
+    def test_divergence(self):
+        log, _ = self.record(6050)
+        # another root node
+        root = behavior_tree.Root(6040)
+        root.start_replay(log)
+        root.tick()
+        self.assertFalse(root.replaying)
+
+        # another leaf than the recorded one
+        behavior_tree.add_node(6050, F['run_until_fail'], children=[6001, 6000])
+        try:
+            root = behavior_tree.Root(6050)
+            root.start_replay(log)
+            root.tick()
+            self.assertFalse(root.replaying)
+            self.assertEqual(root.tick_result, behavior_tree.ERROR)
+        finally:
+            behavior_tree.add_node(6050, F['run_until_fail'], children=[6000, 6001])
+
+    def test_invalid_log(self):
+        log, _ = self.record(6050)
+        root = behavior_tree.Root(6050)
+        self.assertRaises(ValueError, root.start_replay, 'XXXX' + log[4:])
+        self.assertRaises(ValueError, root.start_replay, log[:4] + chr(ord(log[4]) + 1) + log[5:])
+        self.assertRaises(ValueError, root.start_replay, log[:5])
+        self.assertRaises(RuntimeError, root.stop_recording)
+        # a truncated log replays the whole ticks
+        root.start_replay(log[:-1])
+        root.tick()
+        self.assertTrue(root.replaying)
+
+    def test_time_dependent_decorator(self):
+        # the cooldown is over at every other tick while recording, but not in the quick replay
+        log, results = self.record(6011, interval=0.03)
+        self.assertIn(behavior_tree.FAILURE, results)
+        self.assertIn(behavior_tree.SUCCESS, results)
+        root, replayed = self.replay(6011, log)
+        self.assertTrue(root.replaying)
+        self.assertEqual(replayed, results)
+
+    def test_conditions(self):
+        # the conditions are replayed without the columns, ticked alone or in a batch
+        roots = [behavior_tree.Root(6022) for _ in range(3)]
+        for slot, root in enumerate(roots):
+            root.slot = slot
+            root.start_recording()
+        results = []
+        for tick in range(self.TICKS):
+            behavior_tree.set_column(0, [float(tick + slot) for slot in range(3)])
+            behavior_tree.set_column(1, [4.0, 6.0, 8.0])
+            if tick % 2 == 0:
+                behavior_tree.tick_batch(roots)
+            else:
+                for root in roots:
+                    root.tick()
+            results.append([root.tick_result for root in roots])
+        logs = [root.stop_recording() for root in roots]
+        self.assertIn(behavior_tree.SUCCESS, sum(results, []))
+        self.assertIn(behavior_tree.FAILURE, sum(results, []))
+
+        behavior_tree.set_column(0, [])
+        behavior_tree.set_column(1, [])
+        replays = [behavior_tree.Root(6022) for _ in range(3)]
+        for replay, log in zip(replays, logs):
+            replay.start_replay(log)
+        for tick in range(self.TICKS):
+            if tick % 2 == 0:
+                behavior_tree.tick_batch(replays)
+            else:
+                for replay in replays:
+                    replay.tick()
+            self.assertEqual([replay.tick_result for replay in replays], results[tick])
+        self.assertTrue(all(replay.replaying for replay in replays))
+
+    def yielded_root(self):
+        root = behavior_tree.Root(6030)
+        root.time_budget = 0.001
+        root.tick()
+        self.assertTrue(root.yielded)
+        return root
+
+    def test_start_on_yielded_root(self):
+        # the yielded tick starts over instead of being resumed in the log
+        root = self.yielded_root()
+        root.start_recording()
+        for _ in range(10):
+            root.tick()
+            if not root.yielded:
+                break
+        log = root.stop_recording()
+
+        replay = behavior_tree.Root(6030)
+        replay.start_replay(log)
+        replay.tick()
+        self.assertTrue(replay.replaying)
+        self.assertEqual(replay.tick_result, behavior_tree.SUCCESS)
+
+        replay = self.yielded_root()
+        replay.time_budget = 0
+        replay.start_replay(log)
+        replay.tick()
+        self.assertTrue(replay.replaying)
+        self.assertEqual(replay.tick_result, behavior_tree.SUCCESS)
+
+
+if __name__ == '__main__':
+    main()